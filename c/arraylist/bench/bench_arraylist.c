@@ -0,0 +1,188 @@
+/**
+ * Benchmark program for Arraylist.  Also the training run for
+ * profile-guided builds, so it exercises the common paths in the
+ * proportions they are usually run.
+ *
+ * Usage: bench_arraylist [length]
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "../code/arraylist.h"
+
+typedef struct Benchmark {
+    void (*fn)(const int, Value *);
+    char *name;
+} Benchmark;
+
+volatile long sink = 0;
+
+/**
+ * Get the current time in nanoseconds from a monotonic clock.
+ *
+ * Inputs:
+ *     None.
+ * Returns:
+ *     double: Nanoseconds since an arbitrary start.
+*/
+double now_ns() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/**
+ * Append to the end, then drop from the end.
+*/
+void bench_push_back_pop(const int length, Value *values) {
+    const Arraylist a = arraylist_init(0);
+    for (int i = 0; i < length; i++) {
+        arraylist_push_back(a, values[i]);
+    }
+    for (int i = length - 1; i >= 0; i--) {
+        arraylist_pop(a, i);
+    }
+    arraylist_free(a);
+}
+
+/**
+ * Sequential get and set over every index.
+*/
+void bench_get_set(const int length, Value *values) {
+    const Arraylist a = arraylist_init(length);
+    for (int i = 0; i < length; i++) {
+        arraylist_set(a, i, values[i]);
+    }
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < length; i++) {
+            sink += *(int *)arraylist_get(a, i);
+        }
+    }
+    arraylist_free(a);
+}
+
+/**
+ * Callback dereferencing each Value.
+*/
+void sum_fn(Value value) {
+    sink += *(int *)value;
+}
+
+/**
+ * Arraylist over the Values in shuffled order, so dereferences miss.
+*/
+Arraylist shuffled(const int length, Value *values) {
+    const Arraylist a = arraylist_init(length);
+    for (int i = 0; i < length; i++) {
+        arraylist_set(a, i, values[(i * 7919L) % length]);
+    }
+    return a;
+}
+
+/**
+ * Dereferencing scan over shuffled heap objects.
+*/
+void bench_foreach(const int length, Value *values) {
+    const Arraylist a = shuffled(length, values);
+    for (int round = 0; round < 4; round++) {
+        arraylist_foreach(a, (const void (*)(Value))sum_fn);
+    }
+    arraylist_free(a);
+}
+
+/**
+ * Dereferencing scan over shuffled heap objects, prefetching ahead.
+*/
+void bench_foreach_prefetch(const int length, Value *values) {
+    const Arraylist a = shuffled(length, values);
+    for (int round = 0; round < 4; round++) {
+        arraylist_foreach_prefetch(a, (const void (*)(Value))sum_fn, 0);
+    }
+    arraylist_free(a);
+}
+
+/**
+ * Insert and remove near the front, shifting the rest.
+*/
+void bench_push_front(const int length, Value *values) {
+    const int n = length < 20000 ? length : 20000;
+    const Arraylist a = arraylist_init(0);
+    for (int i = 0; i < n; i++) {
+        arraylist_push(a, 0, values[i]);
+    }
+    while (!arraylist_empty(a)) {
+        arraylist_pop(a, 0);
+    }
+    arraylist_free(a);
+}
+
+/**
+ * Lookups through the hash index.
+*/
+void bench_index_of(const int length, Value *values) {
+    const Arraylist a = arraylist_init(0);
+    for (int i = 0; i < length; i++) {
+        arraylist_push_back(a, values[i]);
+    }
+    arraylist_index_enable(a);
+    for (int i = 0; i < length; i++) {
+        sink += arraylist_index_of(a, values[(i * 7919L) % length]);
+    }
+    arraylist_free(a);
+}
+
+/**
+ * Short-lived small lists, allocated fresh and then recycled.
+*/
+void bench_init_free(const int length, Value *values) {
+    for (int pooled = 0; pooled < 2; pooled++) {
+        if (pooled) {
+            arraylist_pool_enable(1 << 20);
+        }
+        for (int i = 0; i < length / 2; i++) {
+            const Arraylist a = arraylist_init(0);
+            arraylist_push_back(a, values[i]);
+            arraylist_free(a);
+        }
+    }
+    arraylist_pool_disable();
+}
+
+const Benchmark BENCHMARKS[] = {
+    { bench_push_back_pop, "bench_push_back_pop" },
+    { bench_get_set, "bench_get_set" },
+    { bench_foreach, "bench_foreach" },
+    { bench_foreach_prefetch, "bench_foreach_prefetch" },
+    { bench_push_front, "bench_push_front" },
+    { bench_index_of, "bench_index_of" },
+    { bench_init_free, "bench_init_free" },
+};
+
+const int NUM_BENCHMARKS = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+
+int main(int argc, char *argv[]) {
+    const int length = (argc > 1) ? atoi(argv[1]) : 1000000;
+    if (length < 1) {
+        fprintf(stderr, "usage: %s [length]\n", argv[0]);
+        return 1;
+    }
+
+    /* Separately allocated objects, as Values usually are */
+    Value *values = malloc(length * sizeof(*values));
+    for (int i = 0; values && i < length; i++) {
+        values[i] = malloc(sizeof(int));
+        *(int *)values[i] = i;
+    }
+
+    for (int i = 0; i < NUM_BENCHMARKS; i++) {
+        const double start = now_ns();
+        BENCHMARKS[i].fn(length, values);
+        printf("%-24s %10.2f ns/op\n", BENCHMARKS[i].name, (now_ns() - start) / length);
+    }
+
+    for (int i = 0; values && i < length; i++) {
+        free(values[i]);
+    }
+    free(values);
+}
@@ -6,15 +6,48 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <limits.h>
+#include <string.h>
+#include <stdint.h>
 #include "arraylist.h"
 
 const unsigned int MIN_CAPACITY = 10;
 const float MIN_FILLED_RATIO = .3;
 const float IDEAL_FILLED_RATIO = .5;
-const float MAX_FILLED_RATIO = .7;
+const float MAX_FILLED_RATIO = ARRAYLIST_MAX_FILLED_RATIO;
+const size_t FRESH_PAGES_MIN_BYTES = 1 << 20;
+const float MAX_INDEX_LOAD = .5;
+
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
 
 bool invalid_index(const Arraylist a, const int index);
-Arraylist fix_capacity(const Arraylist a);
+Arraylist fix_capacity(const Arraylist a, const int length, const int zero_from);
+Arraylist reallocate(const Arraylist a, const int capacity, const int zero_from);
+struct ArraylistIndexEntry *index_find(const struct ArraylistIndex *table, const Value value);
+void index_insert(const Arraylist a, const Value value, const int index);
+void index_remove(const Arraylist a, const Value value, const int index);
+void index_truncate(const Arraylist a, const int length);
+bool index_rebuild(const Arraylist a);
+size_t index_hash(const Value value);
+Arraylist header_alloc(void);
+void header_free(const Arraylist a);
+Value *buffer_alloc(int *capacity);
+void buffer_free(Value *array, const int capacity);
+int capacity_class(const int capacity, const bool round_up);
+
+/* Freed headers and buffers kept by each thread for reuse */
+#define POOL_CLASSES 21  /* Buffers of up to 2^21 - 1 Values are kept */
+struct ArraylistPool {
+    bool enabled;
+    size_t max_bytes;  /* Most memory to retain */
+    size_t retained;  /* Memory retained by headers and buffers */
+    struct Arraylist *headers;  /* Free headers, linked through array */
+    Value *buffers[POOL_CLASSES];  /* Class k holds capacities from 2^k to 2^(k+1) - 1 */
+};
+static _Thread_local struct ArraylistPool pool;
 
 /**
  * Initialized a new Arraylist.
@@ -37,13 +70,13 @@ Arraylist arraylist_init(const int initial_length) {
         ? MIN_CAPACITY
         : ideal_capacity;
 
-    /* Malloc */
-    Arraylist a = malloc(sizeof(*a));
-    Value *array = calloc(initial_capacity, sizeof(*array));
+    /* Malloc, or reuse from the pool */
+    Arraylist a = header_alloc();
+    Value *array = buffer_alloc(&initial_capacity);
 
     if (a == NULL || array == NULL) {
-        free(a);
-        free(array);
+        header_free(a);
+        buffer_free(array, initial_capacity);
         return NULL;
     }
 
@@ -51,6 +84,7 @@ Arraylist arraylist_init(const int initial_length) {
     a->length = initial_length;
     a->capacity = initial_capacity;
     a->array = array;
+    a->index = NULL;
 
     return a;
 }
@@ -65,8 +99,9 @@ Arraylist arraylist_init(const int initial_length) {
 */
 void arraylist_free(Arraylist a) {
     if (a) {
-        free(a->array);
-        free(a);
+        arraylist_index_disable(a);
+        buffer_free(a->array, a->capacity);
+        header_free(a);
     }
 }
 
@@ -105,15 +140,18 @@ Arraylist arraylist_clear(const Arraylist a) {
  *     Value: NULL if the process fails,
  *            Value at the Arraylist's index otherwise.
 */
-Value arraylist_get(const Arraylist a, const int index) {
-    if (invalid_index(a, index)) {
-        return NULL;
-    }
+extern inline Value arraylist_get(const Arraylist a, const int index);
 
-    /* Get value */
-    Value value = a->array[index];
-    return value;
-}
+/**
+ * Get an index's Value from an Arraylist without checking the index.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const int index: The index to access, from 0 to length - 1.
+ * Returns:
+ *     Value: Value at the Arraylist's index.
+*/
+extern inline Value arraylist_get_unchecked(const Arraylist a, const int index);
 
 /**
  * Get an index's Value, remove that item, and shift elements over.
@@ -133,8 +171,13 @@ Value arraylist_pop(const Arraylist a, const int index) {
     /* Get value */
     Value value = a->array[index];
 
-    /* Shift values */
+    /* Shifted indices are rebuilt on the next lookup */
     const int new_length = a->length - 1;
+    if (index < new_length && a->index) {
+        a->index->dirty = true;
+    }
+
+    /* Shift values */
     for (int i = index; i < new_length; i++) {
         a->array[i] = a->array[i + 1];
     }
@@ -169,7 +212,9 @@ Value arraylist_set(const Arraylist a, const int index, const Value value) {
     }
 
     /* Set value */
+    index_remove(a, a->array[index], index);
     a->array[index] = value;
+    index_insert(a, value, index);
     return value;
 }
 
@@ -195,16 +240,52 @@ Value arraylist_push(const Arraylist a, const int index, const Value value) {
         return NULL;
     }
 
-    /* Shift values */
-    for (int i = index; i < new_length - 1; i++) {
-        a->array[i + 1] = a->array[i];
+    /* Shifted indices are rebuilt on the next lookup */
+    if (index < new_length - 1 && a->index) {
+        a->index->dirty = true;
+    }
+
+    /* Shift values, back to front */
+    for (int i = new_length - 1; i > index; i--) {
+        a->array[i] = a->array[i - 1];
     }
 
     /* Set value */
     a->array[index] = value;
+    index_insert(a, value, index);
     return value;
 }
 
+/**
+ * Append a Value to the end of an Arraylist.  Appending while the fill
+ * stays under ARRAYLIST_MAX_FILLED_RATIO is a compare and a store, and
+ * growth past it doubles the capacity, so a run of appends is amortized
+ * O(1) and leaves the same capacity as arraylist_push.
+ * 
+ * Inputs:
+ *     const Arraylist a: The Arraylist to use.
+ *     const Value value: The Value to append.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+extern inline Value arraylist_push_back(const Arraylist a, const Value value);
+
+/**
+ * Append a Value when arraylist_push_back cannot store it directly,
+ * because the internal array must grow or the index must be updated.
+ * 
+ * Inputs:
+ *     const Arraylist a: The Arraylist to use.
+ *     const Value value: The Value to append.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+Value arraylist_push_back_slow(const Arraylist a, const Value value) {
+    return arraylist_push(a, a->length, value);
+}
+
 /**
  * Get the length of the available elements of an Arraylist.
  * 
@@ -213,9 +294,7 @@ Value arraylist_push(const Arraylist a, const int index, const Value value) {
  * Returns:
  *     int: The length of the available elements in the Arraylist.
 */
-int arraylist_length(const Arraylist a) {
-    return a->length;
-}
+extern inline int arraylist_length(const Arraylist a);
 
 /**
  * Get the capacity of the internal array of an Arraylist.
@@ -225,9 +304,7 @@ int arraylist_length(const Arraylist a) {
  * Returns:
  *     int: The capacity of the internal array of the Arraylist.
 */
-int arraylist_capacity(const Arraylist a) {
-    return a->capacity;
-}
+extern inline int arraylist_capacity(const Arraylist a);
 
 /**
  * Reallocates the internal array of an Arraylist to a new size.
@@ -240,28 +317,60 @@ int arraylist_capacity(const Arraylist a) {
  *                Arraylist otherwise.
 */
 Arraylist arraylist_reserve(const Arraylist a, const int capacity) {
-    if (capacity < 0) {
-        return NULL;
-    }
-    
-    Value *array = realloc(a->array, capacity * sizeof(*array));
-    if (!array) {
+    return reallocate(a, capacity, 0);
+}
+
+/**
+ * Reallocates the internal array of an Arraylist to a new size without
+ * zeroing the new elements.  Every element past the old capacity must
+ * be written before it is read, including by a later set, push or
+ * resize that grows the length over it: those expose unwritten
+ * elements as garbage rather than NULL.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const int capacity: The new capacity to use.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                Arraylist otherwise.
+*/
+Arraylist arraylist_reserve_uninit(const Arraylist a, const int capacity) {
+    return reallocate(a, capacity, INT_MAX);
+}
+
+/**
+ * Sets the length of the Arraylist.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const int length: The new length to use.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                Arraylist otherwise.
+*/
+Arraylist arraylist_resize(const Arraylist a, const int length) {
+    if (length < 0) {
         return NULL;
     }
+    index_truncate(a, length);
 
-    /* Zero-out remaining elements */
-    for (int i = a->capacity; i < capacity; i++) {
-        array[i] = NULL;
+    /* Dropped elements read as NULL if the Arraylist grows again */
+    if (length < a->length) {
+        memset(a->array + length, 0, (a->length - length) * sizeof(*a->array));
+        a->length = length;
     }
-
-    a->length = (a->length < capacity) ? a->length : capacity;
-    a->capacity = capacity;
-    a->array = array;
+    if (!fix_capacity(a, length, 0)) {
+        return NULL;
+    }
+    a->length = length;
     return a;
 }
 
 /**
- * Sets the length of the Arraylist.
+ * Sets the length of the Arraylist without zeroing any elements the
+ * internal array grows by up to the new length.  Every element past the
+ * old length must be written before it is read.  Spare capacity past
+ * the new length still reads as NULL.
  * 
  * Inputs:
  *     const Arraylist a: Arraylist to use.
@@ -270,12 +379,190 @@ Arraylist arraylist_reserve(const Arraylist a, const int capacity) {
  *     Arraylist: NULL if the process fails,
  *                Arraylist otherwise.
 */
-Arraylist arraylist_resize(const Arraylist a, const int length) {
+Arraylist arraylist_resize_for_overwrite(const Arraylist a, const int length) {
     if (length < 0) {
         return NULL;
     }
+    index_truncate(a, length);
+
+    /* Overwritten elements are written directly, rebuild on the next lookup */
+    if (length > a->length && a->index) {
+        a->index->dirty = true;
+    }
+
+    /* Dropped elements read as NULL if the Arraylist grows again */
+    if (length < a->length) {
+        memset(a->array + length, 0, (a->length - length) * sizeof(*a->array));
+        a->length = length;
+    }
+
+    /* Only the spare capacity past the new length is zeroed */
+    if (!fix_capacity(a, length, length)) {
+        return NULL;
+    }
+    a->length = length;
+    return a;
+}
+
+/**
+ * Append every element of one Arraylist to another with one resize and
+ * one copy.  The source is left unchanged and may be the destination.
+ * 
+ * Inputs:
+ *     const Arraylist dst: Arraylist to append to.
+ *     const Arraylist src: Arraylist to append from.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                dst otherwise.
+*/
+Arraylist arraylist_concat(const Arraylist dst, const Arraylist src) {
+    const int old_length = dst->length;
+    const int n = src->length;
+    if (n > INT_MAX - old_length) {
+        return NULL;
+    }
+    if (!arraylist_resize(dst, old_length + n)) {
+        return NULL;
+    }
+
+    /* Appended elements are rebuilt on the next lookup */
+    if (n && dst->index) {
+        dst->index->dirty = true;
+    }
+    memcpy(dst->array + old_length, src->array, n * sizeof(*dst->array));
+    return dst;
+}
+
+/**
+ * Move the elements of one Arraylist from an index up to, but not
+ * including, another into a different Arraylist at an index, shifting
+ * elements further back.  The moved elements are removed from the source.
+ * 
+ * Inputs:
+ *     const Arraylist dst: Arraylist to move into.
+ *     const int at: The index of dst to move to, at most its length.
+ *     const Arraylist src: Arraylist to move from, not dst.
+ *     const int from: The first index of src to move.
+ *     const int to: The index of src to stop before.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                dst otherwise.
+*/
+Arraylist arraylist_splice(const Arraylist dst, const int at, const Arraylist src, const int from, const int to) {
+    if (dst == src || at < 0 || at > dst->length || from < 0 || from > to || to > src->length) {
+        return NULL;
+    }
+
+    const int n = to - from;
+    const int old_length = dst->length;
+    if (n > INT_MAX - old_length) {
+        return NULL;
+    }
+    if (n == 0) {
+        return dst;
+    }
+    if (!arraylist_resize(dst, old_length + n)) {
+        return NULL;
+    }
+
+    /* Shifted and moved elements are rebuilt on the next lookup */
+    if (dst->index) {
+        dst->index->dirty = true;
+    }
+    if (to < src->length && src->index) {
+        src->index->dirty = true;
+    }
+
+    /* Open a gap in dst, fill it, then close the gap in src */
+    memmove(dst->array + at + n, dst->array + at, (old_length - at) * sizeof(*dst->array));
+    memcpy(dst->array + at, src->array + from, n * sizeof(*dst->array));
+    memmove(src->array + from, src->array + to, (src->length - to) * sizeof(*src->array));
+    if (!arraylist_resize(src, src->length - n)) {
+        return NULL;
+    }
+    return dst;
+}
+
+/**
+ * Exchange the contents of two Arraylists, indices included, in O(1).
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to swap.
+ *     const Arraylist b: Arraylist to swap.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_swap(const Arraylist a, const Arraylist b) {
+    const struct Arraylist temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/**
+ * Take ownership of the internal array of an Arraylist without copying,
+ * leaving the Arraylist empty with a new array.  The caller frees the
+ * taken array with free.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to take from.
+ *     int *length: Set to the number of elements in the taken array.
+ *     int *capacity: Set to the capacity of the taken array, may be NULL.
+ * Returns:
+ *     Value *: NULL if the process fails,
+ *              internal array that was taken otherwise.
+*/
+Value *arraylist_take_buffer(const Arraylist a, int *length, int *capacity) {
+    int replacement_capacity = MIN_CAPACITY;
+    Value *replacement = buffer_alloc(&replacement_capacity);
+    if (replacement == NULL) {
+        return NULL;
+    }
+
+    Value *array = a->array;
+    *length = a->length;
+    if (capacity) {
+        *capacity = a->capacity;
+    }
+
+    /* Every indexed element left with the array */
+    if (a->index) {
+        a->index->dirty = true;
+    }
+    a->length = 0;
+    a->capacity = replacement_capacity;
+    a->array = replacement;
+    return array;
+}
+
+/**
+ * Give an Arraylist ownership of an array without copying, freeing the
+ * Arraylist's current elements array.  Slots past the length are
+ * cleared to NULL.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to give to.
+ *     Value *array: Array allocated with malloc, calloc or realloc.
+ *     const int length: Number of elements in use.
+ *     const int capacity: Allocated length of the array, at least length
+ *                         and at least 1.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                a otherwise.
+*/
+Arraylist arraylist_adopt_buffer(const Arraylist a, Value *array, const int length, const int capacity) {
+    if (array == NULL || array == a->array || length < 0 || capacity < 1 || length > capacity) {
+        return NULL;
+    }
+
+    memset(array + length, 0, (size_t)(capacity - length) * sizeof(*array));
+    buffer_free(a->array, a->capacity);
+    if (a->index) {
+        a->index->dirty = true;
+    }
     a->length = length;
-    return fix_capacity(a);
+    a->capacity = capacity;
+    a->array = array;
+    return a;
 }
 
 /**
@@ -310,6 +597,352 @@ void arraylist_map(const Arraylist a, Value (*f)(Value)) {
     }
 }
 
+/**
+ * Calls a function once for each element in the Arraylist, like
+ * arraylist_foreach, while prefetching the Value distance elements ahead
+ * so callbacks that dereference each Value do not stall on cache misses.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const void (*f)(Value): Function to call for each element.
+ *     const int distance: Elements to prefetch ahead, below 1 uses
+ *                         ARRAYLIST_PREFETCH_DISTANCE.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_foreach_prefetch(const Arraylist a, const void (*f)(Value), const int distance) {
+    const int ahead = (distance < 1) ? ARRAYLIST_PREFETCH_DISTANCE : distance;
+    const int length = a->length;
+    int i = 0;
+
+    /* Prefetching never faults, but stop early to skip the bounds check */
+    for (; i < length - ahead; i++) {
+        PREFETCH(a->array[i + ahead]);
+        f(a->array[i]);
+    }
+    for (; i < length; i++) {
+        f(a->array[i]);
+    }
+}
+
+/**
+ * Gathers the Values at several indices of the Arraylist, prefetching
+ * the Value distance indices ahead so callers that dereference the
+ * gathered Values do not stall on cache misses.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const int *indices: The indices to access.
+ *     const int n: Length of indices.
+ *     Value *out: Array of at least n Values to fill, in order of indices.
+ *     const int distance: Indices to prefetch ahead, below 1 uses
+ *                         ARRAYLIST_PREFETCH_DISTANCE.
+ * Returns:
+ *     Value *: NULL if any index is invalid, with its slot set to NULL,
+ *              out otherwise.
+*/
+Value *arraylist_get_many(const Arraylist a, const int *indices, const int n, Value *out, const int distance) {
+    const int ahead = (distance < 1) ? ARRAYLIST_PREFETCH_DISTANCE : distance;
+    bool valid = true;
+    for (int i = 0; i < n; i++) {
+        if (i < n - ahead) {
+            const int next = indices[i + ahead];
+            if (next >= 0 && next < a->length) {
+                PREFETCH(a->array[next]);
+            }
+        }
+
+        const int index = indices[i];
+        if (index < 0 || index >= a->length) {
+            out[i] = NULL;
+            valid = false;
+        } else {
+            out[i] = a->array[index];
+        }
+    }
+    return valid ? out : NULL;
+}
+
+/**
+ * Attach a hash index mapping each distinct non-NULL Value to its lowest
+ * index and count, or rebuild it if already attached.  Set, push, pop and resize keep the
+ * index up to date; writing a->array directly requires calling this
+ * again.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                Arraylist otherwise.
+*/
+Arraylist arraylist_index_enable(const Arraylist a) {
+    if (a->index == NULL) {
+        a->index = calloc(1, sizeof(*a->index));
+        if (a->index == NULL) {
+            return NULL;
+        }
+    }
+
+    if (!index_rebuild(a)) {
+        arraylist_index_disable(a);
+        return NULL;
+    }
+    return a;
+}
+
+/**
+ * Detach and free the hash index of an Arraylist.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_index_disable(const Arraylist a) {
+    if (a->index) {
+        free(a->index->slots);
+        free(a->index);
+        a->index = NULL;
+    }
+}
+
+/**
+ * Find the first index holding a Value.  Uses the hash index when one is
+ * attached, rebuilding it first after shifting operations, and scans the
+ * Arraylist otherwise.  An indexed lookup is O(1), except the first one
+ * after the lowest copy of a repeated Value is overwritten or popped:
+ * it scans forward to the next copy and remembers it.  Alternately
+ * removing and restoring the lowest copy of a Value whose other copies
+ * sit far behind it makes every such lookup O(length).
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const Value value: The Value to find.
+ * Returns:
+ *     int: -1 if the Value is not in the Arraylist,
+ *          lowest index holding the Value otherwise.
+*/
+int arraylist_index_of(const Arraylist a, const Value value) {
+    /* Scan */
+    if (a->index == NULL || value == NULL || (a->index->dirty && !index_rebuild(a))) {
+        for (int i = 0; i < a->length; i++) {
+            if (a->array[i] == value) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /* Probe for the Value's one entry */
+    struct ArraylistIndexEntry *entry = index_find(a->index, value);
+    if (entry->value == NULL) {
+        return -1;
+    }
+
+    /* Removing the lowest occurrence leaves a bound, settle it on the next one */
+    int i = entry->index;
+    while (i < a->length && a->array[i] != value) {
+        i++;
+    }
+    entry->index = i;
+    return i < a->length ? i : -1;
+}
+
+/**
+ * Create a View of every stride-th element of an Arraylist from an index
+ * up to, but not including, another.  Views borrow the internal array
+ * and are invalidated once the Arraylist reallocates or is freed.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to view.
+ *     const int from: The first index to view.
+ *     const int to: The index to stop before, at most the length.
+ *     const int stride: Elements between consecutive viewed elements.
+ * Returns:
+ *     ArraylistView: View with a NULL array if the process fails,
+ *                    View of the range otherwise.
+*/
+ArraylistView arraylist_view(const Arraylist a, const int from, const int to, const int stride) {
+    if (from < 0 || to > a->length || from > to || stride < 1) {
+        return (ArraylistView){ NULL, NULL, 0, 1 };
+    }
+    return (ArraylistView){ a, a->array + from, (to - from + stride - 1) / stride, stride };
+}
+
+/**
+ * Get an index's Value from a View.
+ * 
+ * Inputs:
+ *     const ArraylistView v: View to use.
+ *     const int index: The index within the View to access.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value at the View's index otherwise.
+*/
+Value arraylist_view_get(const ArraylistView v, const int index) {
+    if (index < 0 || index >= v.length) {
+        return NULL;
+    }
+    return v.array[(size_t)index * v.stride];
+}
+
+/**
+ * Calls a function once for each element in the View, in order.
+ * 
+ * Inputs:
+ *     const ArraylistView v: View to use.
+ *     const void (*f)(Value): Function to call for each element.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_view_foreach(const ArraylistView v, const void (*f)(Value)) {
+    Value *element = v.array;
+    for (int i = 0; i < v.length; i++, element += v.stride) {
+        f(*element);
+    }
+}
+
+/**
+ * Calls a function once for each element in the View, in order, setting
+ * each element of the underlying Arraylist with the return.  An attached
+ * index is marked for rebuilding, so concurrent maps over disjoint Views
+ * should run with the index disabled.
+ * 
+ * Inputs:
+ *     const ArraylistView v: View to use.
+ *     Value (*f)(Value): Function to call for each element.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_view_map(const ArraylistView v, Value (*f)(Value)) {
+    if (v.length && v.list->index) {
+        v.list->index->dirty = true;
+    }
+
+    Value *element = v.array;
+    for (int i = 0; i < v.length; i++, element += v.stride) {
+        *element = f(*element);
+    }
+}
+
+/**
+ * Get the first index of a Value within a View.
+ * 
+ * Inputs:
+ *     const ArraylistView v: View to use.
+ *     const Value value: The Value to find.
+ * Returns:
+ *     int: -1 if the Value is not in the View,
+ *          first index within the View holding the Value otherwise.
+*/
+int arraylist_view_index_of(const ArraylistView v, const Value value) {
+    const Value *element = v.array;
+    for (int i = 0; i < v.length; i++, element += v.stride) {
+        if (*element == value) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Split a View into consecutive parts whose lengths differ by at most
+ * one, such as one per worker thread.  No elements are copied.
+ * 
+ * Inputs:
+ *     const ArraylistView v: View to split.
+ *     const int n: Number of parts.
+ *     ArraylistView *parts: Array of at least n Views to fill, in order.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          n otherwise.
+*/
+int arraylist_view_split(const ArraylistView v, const int n, ArraylistView *parts) {
+    if (n < 1) {
+        return -1;
+    }
+
+    /* The first length % n parts take one extra element */
+    const int base = v.length / n;
+    const int extra = v.length % n;
+    Value *array = v.array;
+    for (int i = 0; i < n; i++) {
+        const int length = base + (i < extra);
+        parts[i] = (ArraylistView){ v.list, array, length, v.stride };
+        array += (size_t)length * v.stride;
+    }
+    return n;
+}
+
+/**
+ * Start recycling freed Arraylist headers and buffers on the calling
+ * thread, so later arraylist_init calls on it reuse them instead of
+ * allocating.  Recycled buffers keep their capacity, so capacities may
+ * exceed what a fresh Arraylist would get.  Call arraylist_pool_disable
+ * before the thread exits to release what is retained.
+ * 
+ * Inputs:
+ *     const size_t max_bytes: Most memory to retain, freeing the rest.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_pool_enable(const size_t max_bytes) {
+    pool.enabled = true;
+    pool.max_bytes = max_bytes;
+    arraylist_pool_trim(max_bytes);
+}
+
+/**
+ * Stop recycling on the calling thread and free everything retained.
+ * 
+ * Inputs:
+ *     None.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_pool_disable(void) {
+    arraylist_pool_trim(0);
+    pool.enabled = false;
+}
+
+/**
+ * Free retained headers and buffers on the calling thread, largest
+ * buffers first, until at most a number of bytes are retained.
+ * 
+ * Inputs:
+ *     const size_t max_bytes: Most memory to leave retained.
+ * Returns:
+ *     Nothing.
+*/
+void arraylist_pool_trim(const size_t max_bytes) {
+    for (int k = POOL_CLASSES - 1; k >= 0 && pool.retained > max_bytes; k--) {
+        while (pool.buffers[k] && pool.retained > max_bytes) {
+            Value *array = pool.buffers[k];
+            pool.buffers[k] = array[0];
+            pool.retained -= (size_t)(intptr_t)array[1] * sizeof(*array);
+            free(array);
+        }
+    }
+    while (pool.headers && pool.retained > max_bytes) {
+        struct Arraylist *a = pool.headers;
+        pool.headers = (struct Arraylist *)a->array;
+        pool.retained -= sizeof(*a);
+        free(a);
+    }
+}
+
+/**
+ * Get the memory retained for recycling on the calling thread.
+ * 
+ * Inputs:
+ *     None.
+ * Returns:
+ *     size_t: Bytes of retained headers and buffers.
+*/
+size_t arraylist_pool_retained(void) {
+    return pool.retained;
+}
+
 /**
  * Whether an input index is not accessible in the Arraylist.
  * 
@@ -324,31 +957,375 @@ bool invalid_index(const Arraylist a, const int index) {
 }
 
 /**
- * Update the size of the internal array and the Arraylist size attribute.
+ * Update the size of the internal array for a new length.  The caller
+ * sets the length afterwards, so only the elements already in use are
+ * copied if the array moves.
  * 
  * Inputs:
  *     const Arraylist a: Arraylist to change the size of.
+ *     const int length: The length the Arraylist is about to have.
+ *     const int zero_from: First index the internal array grows by that must read as NULL.
  * Returns:
  *     Arraylist: NULL if the process fails,
  *                Arraylist otherwise.
 */
-Arraylist fix_capacity(const Arraylist a) {
+Arraylist fix_capacity(const Arraylist a, const int length, const int zero_from) {
     /* In good range */
-    float curr_ratio = (float)a->length / (float)a->capacity;
+    float curr_ratio = (float)length / (float)a->capacity;
     if (curr_ratio > MIN_FILLED_RATIO && curr_ratio < MAX_FILLED_RATIO) {
         return a;
     }
 
-    int new_capacity = (int)(a->length / IDEAL_FILLED_RATIO);
+    int new_capacity = (int)(length / IDEAL_FILLED_RATIO);
 
     /* Reserve min capacity */
     if (new_capacity < MIN_CAPACITY) {
-        return arraylist_reserve(a, MIN_CAPACITY);
+        return reallocate(a, MIN_CAPACITY, zero_from);
     }
 
     /* Reserve max capacity */
     if (new_capacity > INT_MAX && a->capacity < INT_MAX) {
-        return arraylist_reserve(a, INT_MAX);
+        return reallocate(a, INT_MAX, zero_from);
+    }
+    return reallocate(a, new_capacity, zero_from);
+}
+
+/**
+ * Reallocates the internal array of an Arraylist to a new size.
+ * Large zeroed growth takes a fresh calloc instead of realloc, so the
+ * new elements come from untouched zero pages rather than a zeroing loop.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const int capacity: The new capacity to use.
+ *     const int zero_from: First index past the old capacity to zero,
+ *                          INT_MAX to zero nothing.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                Arraylist otherwise.
+*/
+Arraylist reallocate(const Arraylist a, const int capacity, const int zero_from) {
+    if (capacity < 0) {
+        return NULL;
+    }
+
+    const int length = (a->length < capacity) ? a->length : capacity;
+    const int grow_from = (zero_from > a->capacity) ? zero_from : a->capacity;
+    const size_t growth =
+        (capacity > grow_from)
+        ? (size_t)(capacity - grow_from) * sizeof(*a->array)
+        : 0;
+
+    Value *array;
+    if (growth >= FRESH_PAGES_MIN_BYTES || length < a->length) {
+        /*
+         * Copy only the elements in use into fresh zero pages.  Dropping
+         * elements also takes a fresh array, so the index forgets them
+         * only once the allocation has succeeded.
+         */
+        array = calloc(capacity, sizeof(*array));
+        if (!array && capacity > 0) {
+            return NULL;
+        }
+        memcpy(array, a->array, length * sizeof(*array));
+        index_truncate(a, length);
+        free(a->array);
+    } else {
+        array = realloc(a->array, capacity * sizeof(*array));
+        if (!array && capacity > 0) {
+            return NULL;
+        }
+
+        /* Zero-out remaining elements */
+        if (growth > 0) {
+            memset(array + grow_from, 0, growth);
+        }
+    }
+
+    a->length = length;
+    a->capacity = capacity;
+    a->array = array;
+    return a;
+}
+
+/**
+ * Hash a Value for the index.
+ * 
+ * Inputs:
+ *     const Value value: The Value to hash.
+ * Returns:
+ *     size_t: The hash, well mixed in every bit.
+*/
+size_t index_hash(const Value value) {
+    uint64_t hash = (uint64_t)(uintptr_t)value;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (size_t)hash;
+}
+
+/**
+ * Find the slot of a Value's entry, or the empty slot ending its probe run.
+ * 
+ * Inputs:
+ *     const struct ArraylistIndex *table: Index to probe.
+ *     const Value value: The non-NULL Value to find.
+ * Returns:
+ *     struct ArraylistIndexEntry *: Slot of the entry, with a NULL value if absent.
+*/
+struct ArraylistIndexEntry *index_find(const struct ArraylistIndex *table, const Value value) {
+    const size_t mask = table->capacity - 1;
+    size_t slot = index_hash(value) & mask;
+    while (table->slots[slot].value && table->slots[slot].value != value) {
+        slot = (slot + 1) & mask;
+    }
+    return &table->slots[slot];
+}
+
+/**
+ * Record that a Value is at an index, if an up-to-date index is attached.
+ * Repeated Values share one entry, so recording is O(1) however many
+ * copies the Arraylist holds.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const Value value: The Value to record, NULL is not indexed.
+ *     const int index: The index holding the Value.
+ * Returns:
+ *     Nothing.
+*/
+void index_insert(const Arraylist a, const Value value, const int index) {
+    struct ArraylistIndex *table = a->index;
+    if (table == NULL || table->dirty || value == NULL) {
+        return;
+    }
+
+    /* Another occurrence */
+    struct ArraylistIndexEntry *entry = index_find(table, value);
+    if (entry->value) {
+        entry->count++;
+        if (index < entry->index) {
+            entry->index = index;
+        }
+        return;
+    }
+
+    /* Grow by rebuilding, which records the new Value too */
+    if (table->count + 1 > table->capacity * MAX_INDEX_LOAD) {
+        table->dirty = true;
+        return;
+    }
+    *entry = (struct ArraylistIndexEntry){ value, index, 1 };
+    table->count++;
+}
+
+/**
+ * Forget that a Value is at an index, if an up-to-date index is attached.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const Value value: The Value to forget, NULL is not indexed.
+ *     const int index: The index that held the Value.
+ * Returns:
+ *     Nothing.
+*/
+void index_remove(const Arraylist a, const Value value, const int index) {
+    struct ArraylistIndex *table = a->index;
+    if (table == NULL || table->dirty || value == NULL) {
+        return;
+    }
+
+    /* Find the entry, other occurrences keep it */
+    struct ArraylistIndexEntry *entry = index_find(table, value);
+    if (entry->value == NULL) {
+        return;
+    }
+    if (--entry->count > 0) {
+        /* Later occurrences remain, index_of settles on the next one */
+        if (index == entry->index) {
+            entry->index = index + 1;
+        }
+        return;
+    }
+
+    /* Shift later entries of the run back so probing needs no tombstones */
+    const size_t mask = table->capacity - 1;
+    size_t hole = entry - table->slots;
+    for (size_t next = (hole + 1) & mask; table->slots[next].value; next = (next + 1) & mask) {
+        const size_t home = index_hash(table->slots[next].value) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table->slots[hole] = table->slots[next];
+            hole = next;
+        }
+    }
+    table->slots[hole].value = NULL;
+    table->count--;
+}
+
+/**
+ * Forget Values at or past a new, shorter length.  Dropping more than
+ * half the elements marks the index for a rebuild instead.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const int length: The new length.
+ * Returns:
+ *     Nothing.
+*/
+void index_truncate(const Arraylist a, const int length) {
+    if (a->index == NULL || a->index->dirty || length >= a->length) {
+        return;
+    }
+    if (a->length - length > a->length / 2) {
+        a->index->dirty = true;
+        return;
+    }
+    for (int i = length; i < a->length; i++) {
+        index_remove(a, a->array[i], i);
+    }
+}
+
+/**
+ * Re-record every non-NULL Value of the Arraylist in its index, sizing
+ * the slots for the current length.
+ * 
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ * Returns:
+ *     bool: Whether the process succeeded.
+*/
+bool index_rebuild(const Arraylist a) {
+    struct ArraylistIndex *table = a->index;
+
+    /* Smallest power of two within the load limit */
+    int capacity = 16;
+    while (capacity < INT_MAX / 2 && a->length + 1 > capacity * MAX_INDEX_LOAD) {
+        capacity *= 2;
+    }
+
+    if (capacity != table->capacity) {
+        struct ArraylistIndexEntry *slots = malloc(capacity * sizeof(*slots));
+        if (slots == NULL) {
+            return false;
+        }
+        free(table->slots);
+        table->slots = slots;
+        table->capacity = capacity;
+    }
+    memset(table->slots, 0, capacity * sizeof(*table->slots));
+    table->count = 0;
+    table->dirty = false;
+
+    for (int i = 0; i < a->length; i++) {
+        index_insert(a, a->array[i], i);
+    }
+    return true;
+}
+
+/**
+ * Allocate an Arraylist header, reusing a pooled one if possible.
+ * 
+ * Inputs:
+ *     None.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                uninitialized header otherwise.
+*/
+Arraylist header_alloc(void) {
+    if (pool.headers) {
+        Arraylist a = pool.headers;
+        pool.headers = (struct Arraylist *)a->array;
+        pool.retained -= sizeof(*a);
+        return a;
+    }
+    return malloc(sizeof(struct Arraylist));
+}
+
+/**
+ * Free an Arraylist header, or keep it in the pool.
+ * 
+ * Inputs:
+ *     const Arraylist a: Header to free, may be NULL.
+ * Returns:
+ *     Nothing.
+*/
+void header_free(const Arraylist a) {
+    if (a && pool.enabled && pool.retained + sizeof(*a) <= pool.max_bytes) {
+        a->array = (Value *)pool.headers;
+        pool.headers = a;
+        pool.retained += sizeof(*a);
+        return;
+    }
+    free(a);
+}
+
+/**
+ * Allocate a zeroed elements array, reusing a pooled one of at least the
+ * requested capacity if possible.
+ * 
+ * Inputs:
+ *     int *capacity: The capacity to allocate, set to the capacity
+ *                    of the array returned.
+ * Returns:
+ *     Value *: NULL if the process fails,
+ *              zeroed array otherwise.
+*/
+Value *buffer_alloc(int *capacity) {
+    const int k = capacity_class(*capacity, true);
+    if (k >= 0 && k < POOL_CLASSES && pool.buffers[k]) {
+        /* Pooled buffers store the next buffer and their capacity up front */
+        Value *array = pool.buffers[k];
+        pool.buffers[k] = array[0];
+        *capacity = (int)(intptr_t)array[1];
+        pool.retained -= (size_t)*capacity * sizeof(*array);
+        memset(array, 0, (size_t)*capacity * sizeof(*array));
+        return array;
+    }
+    return calloc(*capacity, sizeof(Value));
+}
+
+/**
+ * Free an elements array, or keep it in the pool under its size class.
+ * 
+ * Inputs:
+ *     Value *array: Array to free, may be NULL.
+ *     const int capacity: Capacity of the array.
+ * Returns:
+ *     Nothing.
+*/
+void buffer_free(Value *array, const int capacity) {
+    const int k = capacity_class(capacity, false);
+    const size_t bytes = (size_t)capacity * sizeof(*array);
+    if (array && pool.enabled && capacity >= 2 && k < POOL_CLASSES && pool.retained + bytes <= pool.max_bytes) {
+        array[0] = pool.buffers[k];
+        array[1] = (Value)(intptr_t)capacity;
+        pool.buffers[k] = array;
+        pool.retained += bytes;
+        return;
+    }
+    free(array);
+}
+
+/**
+ * Get the power-of-two size class of a capacity.
+ * 
+ * Inputs:
+ *     const int capacity: The capacity to classify.
+ *     const bool round_up: Whether to take the class whose every buffer
+ *                          holds the capacity, rather than the class the
+ *                          capacity belongs to.
+ * Returns:
+ *     int: -1 if the capacity is below 1,
+ *          size class otherwise.
+*/
+int capacity_class(const int capacity, const bool round_up) {
+    if (capacity < 1) {
+        return -1;
+    }
+
+    int k = 0;
+    while (k < 31 && (1 << k) <= capacity >> 1) {
+        k++;
     }
-    return arraylist_reserve(a, new_capacity);
+    return (round_up && (1 << k) < capacity) ? k + 1 : k;
 }
\ No newline at end of file
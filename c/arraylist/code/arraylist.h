@@ -6,14 +6,47 @@
 #define ARRAYLIST_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 
-typedef struct Arraylist *Arraylist;
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARRAYLIST_PREFETCH_DISTANCE 8  /* Default elements to prefetch ahead */
+#define ARRAYLIST_MAX_FILLED_RATIO .7f  /* Fill ratio at which growth reallocates */
+
+/* C++ cannot give a typedef its struct's name, so it sees another tag */
+#ifdef __cplusplus
+#define ARRAYLIST_TAG ArraylistStruct
+#else
+#define ARRAYLIST_TAG Arraylist
+#endif
+
+typedef struct ARRAYLIST_TAG *Arraylist;
 typedef void *Value;
-struct Arraylist {
+struct ARRAYLIST_TAG {
     int length;  /* Length of elements */
     int capacity;  /* Length of internal array */
     Value *array;
+    struct ArraylistIndex *index;  /* Value to index lookup, NULL if disabled */
+};
+struct ArraylistIndexEntry {
+    Value value;  /* NULL for an empty slot */
+    int index;  /* At or before the lowest index holding value */
+    int count;  /* Occurrences of value */
 };
+struct ArraylistIndex {
+    int count;  /* Length of entries, one per distinct Value */
+    int capacity;  /* Length of slots, a power of two */
+    bool dirty;  /* Whether entries must be rebuilt before the next lookup */
+    struct ArraylistIndexEntry *slots;
+};
+typedef struct ArraylistView {
+    Arraylist list;  /* Arraylist the elements belong to */
+    Value *array;  /* First element, NULL for an invalid View */
+    int length;  /* Length of elements */
+    int stride;  /* Distance in Values between consecutive elements */
+} ArraylistView;
 
 /* Initialize/Free */
 Arraylist arraylist_init(const int initial_len);
@@ -22,21 +55,83 @@ void arraylist_free(const Arraylist a);
 /* Get/Remove internal array elements */
 bool arraylist_empty(const Arraylist a);
 Arraylist arraylist_clear(const Arraylist a);
-Value arraylist_get(const Arraylist a, const int index);
 Value arraylist_pop(const Arraylist a, const int index);
 Value arraylist_set(const Arraylist a, const int index, const Value value);
 Value arraylist_push(const Arraylist a, const int index, const Value value);
+Value arraylist_push_back_slow(const Arraylist a, const Value value);
+
+/* Inline fast paths, with out-of-line copies emitted by arraylist.c */
+inline Value arraylist_get(const Arraylist a, const int index) {
+    /* One unsigned compare rejects both negative and past-the-end indices */
+    if ((unsigned int)index >= (unsigned int)a->length) {
+        return NULL;
+    }
+    return a->array[index];
+}
+
+inline Value arraylist_get_unchecked(const Arraylist a, const int index) {
+    return a->array[index];
+}
+
+inline Value arraylist_push_back(const Arraylist a, const Value value) {
+    /* Store while the new fill stays under the ratio arraylist_resize grows at */
+    if (a->length < a->capacity && a->index == NULL
+        && (float)(a->length + 1) / (float)a->capacity < ARRAYLIST_MAX_FILLED_RATIO) {
+        a->array[a->length++] = value;
+        return value;
+    }
+    return arraylist_push_back_slow(a, value);
+}
 
 /* Get size */
-int arraylist_length(const Arraylist a);
-int arraylist_capacity(const Arraylist a);
+inline int arraylist_length(const Arraylist a) {
+    return a->length;
+}
+
+inline int arraylist_capacity(const Arraylist a) {
+    return a->capacity;
+}
 
 /* Set size */
 Arraylist arraylist_resize(const Arraylist a, const int length);
 Arraylist arraylist_reserve(const Arraylist a, const int capacity);
+Arraylist arraylist_resize_for_overwrite(const Arraylist a, const int length);
+Arraylist arraylist_reserve_uninit(const Arraylist a, const int capacity);
+
+/* Move elements */
+Arraylist arraylist_concat(const Arraylist dst, const Arraylist src);
+Arraylist arraylist_splice(const Arraylist dst, const int at, const Arraylist src, const int from, const int to);
+void arraylist_swap(const Arraylist a, const Arraylist b);
+Value *arraylist_take_buffer(const Arraylist a, int *length, int *capacity);
+Arraylist arraylist_adopt_buffer(const Arraylist a, Value *array, const int length, const int capacity);
 
 /* Iterate */
 void arraylist_foreach(const Arraylist a, const void (*f)(Value));
 void arraylist_map(const Arraylist a, const Value (*f)(Value));
+void arraylist_foreach_prefetch(const Arraylist a, const void (*f)(Value), const int distance);
+Value *arraylist_get_many(const Arraylist a, const int *indices, const int n, Value *out, const int distance);
+
+/* Search */
+Arraylist arraylist_index_enable(const Arraylist a);
+void arraylist_index_disable(const Arraylist a);
+int arraylist_index_of(const Arraylist a, const Value value);
+
+/* Views */
+ArraylistView arraylist_view(const Arraylist a, const int from, const int to, const int stride);
+Value arraylist_view_get(const ArraylistView v, const int index);
+void arraylist_view_foreach(const ArraylistView v, const void (*f)(Value));
+void arraylist_view_map(const ArraylistView v, Value (*f)(Value));
+int arraylist_view_index_of(const ArraylistView v, const Value value);
+int arraylist_view_split(const ArraylistView v, const int n, ArraylistView *parts);
+
+/* Recycling, per thread */
+void arraylist_pool_enable(const size_t max_bytes);
+void arraylist_pool_disable(void);
+void arraylist_pool_trim(const size_t max_bytes);
+size_t arraylist_pool_retained(void);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
\ No newline at end of file
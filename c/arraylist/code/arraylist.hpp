@@ -0,0 +1,385 @@
+/**
+ * Header file for the C++ Arraylist wrapper.
+ *
+ * arraylist<T, Alloc> owns an Arraylist of elements.  A trivially
+ * copyable T that fits in a Value is stored in the Value itself, any
+ * other T is allocated and constructed through Alloc and the Value points
+ * to it.  Moving steals the Arraylist without touching the elements,
+ * iterators are random access so the <algorithm> and std::execution
+ * algorithms apply, and failed allocations throw std::bad_alloc.
+ * arraylist_handle exposes the underlying Arraylist for C code that reads
+ * the Values as T *, or as the T bits themselves when stored inline.
+*/
+
+#ifndef ARRAYLIST_HPP_
+#define ARRAYLIST_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "arraylist.h"
+
+namespace datastructures {
+
+template <typename T, typename Alloc = std::allocator<T>>
+class arraylist {
+    using alloc_traits = std::allocator_traits<Alloc>;
+    static_assert(std::is_same<typename alloc_traits::value_type, T>::value,
+                  "Alloc must allocate T");
+
+    /* Small trivially copyable elements live in the Value, others are boxed */
+    using stored_inline = std::integral_constant<bool,
+        std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(Value) && alignof(T) <= alignof(Value)>;
+
+public:
+    /* Random access over the Values, dereferencing each to its element */
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T *, T *>::type;
+        using reference = typename std::conditional<Const, const T &, T &>::type;
+
+        basic_iterator() : slot_(nullptr) {}
+        explicit basic_iterator(Value *slot) : slot_(slot) {}
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        basic_iterator(const basic_iterator<false> &other) : slot_(other.slot()) {}
+
+        reference operator*() const { return *element(slot_); }
+        pointer operator->() const { return element(slot_); }
+        reference operator[](difference_type n) const { return *element(slot_ + n); }
+
+        basic_iterator &operator++() { ++slot_; return *this; }
+        basic_iterator operator++(int) { basic_iterator old = *this; ++slot_; return old; }
+        basic_iterator &operator--() { --slot_; return *this; }
+        basic_iterator operator--(int) { basic_iterator old = *this; --slot_; return old; }
+        basic_iterator &operator+=(difference_type n) { slot_ += n; return *this; }
+        basic_iterator &operator-=(difference_type n) { slot_ -= n; return *this; }
+        friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const basic_iterator &a, const basic_iterator &b) { return a.slot_ - b.slot_; }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) { return a.slot_ == b.slot_; }
+        friend bool operator!=(const basic_iterator &a, const basic_iterator &b) { return a.slot_ != b.slot_; }
+        friend bool operator<(const basic_iterator &a, const basic_iterator &b) { return a.slot_ < b.slot_; }
+        friend bool operator>(const basic_iterator &a, const basic_iterator &b) { return a.slot_ > b.slot_; }
+        friend bool operator<=(const basic_iterator &a, const basic_iterator &b) { return a.slot_ <= b.slot_; }
+        friend bool operator>=(const basic_iterator &a, const basic_iterator &b) { return a.slot_ >= b.slot_; }
+
+        Value *slot() const { return slot_; }
+
+    private:
+        Value *slot_;
+    };
+
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = typename alloc_traits::pointer;
+    using const_pointer = typename alloc_traits::const_pointer;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /* Initialize/Free */
+    arraylist() : arraylist(Alloc()) {}
+    explicit arraylist(const Alloc &alloc) : list_(nullptr), alloc_(alloc) {}
+    explicit arraylist(size_type n, const T &value = T(), const Alloc &alloc = Alloc()) : arraylist(alloc) {
+        reserve(n);
+        for (size_type i = 0; i < n; i++) {
+            push_back(value);
+        }
+    }
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    arraylist(InputIt first, InputIt last, const Alloc &alloc = Alloc()) : arraylist(alloc) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+    arraylist(std::initializer_list<T> values, const Alloc &alloc = Alloc())
+        : arraylist(values.begin(), values.end(), alloc) {}
+
+    arraylist(const arraylist &other)
+        : arraylist(other.begin(), other.end(), alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    /* Steals the Arraylist, leaving other empty */
+    arraylist(arraylist &&other) noexcept : list_(other.list_), alloc_(std::move(other.alloc_)) {
+        other.list_ = nullptr;
+    }
+
+    ~arraylist() {
+        clear();
+        arraylist_free(list_);
+    }
+
+    arraylist &operator=(const arraylist &other) {
+        if (this != &other) {
+            arraylist copy(other.begin(), other.end(),
+                           alloc_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : alloc_);
+            swap_contents(copy);
+        }
+        return *this;
+    }
+
+    arraylist &operator=(arraylist &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+        if (alloc_traits::propagate_on_container_move_assignment::value || alloc_ == other.alloc_) {
+            /* Elements were allocated by an equal allocator, steal them */
+            clear();
+            arraylist_free(list_);
+            list_ = other.list_;
+            other.list_ = nullptr;
+            move_allocator(other, typename alloc_traits::propagate_on_container_move_assignment());
+        } else {
+            /* Unequal allocators must reallocate every element */
+            clear();
+            reserve(other.size());
+            for (T &value : other) {
+                emplace_back(std::move(value));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    arraylist &operator=(std::initializer_list<T> values) {
+        arraylist copy(values, alloc_);
+        swap_contents(copy);
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    /* Handle for C code, owned by this arraylist, NULL while empty */
+    Arraylist arraylist_handle() const { return list_; }
+
+    /* Get elements */
+    reference operator[](size_type i) { return *element(list_->array + i); }
+    const_reference operator[](size_type i) const { return *element(list_->array + i); }
+    reference at(size_type i) {
+        check(i);
+        return (*this)[i];
+    }
+    const_reference at(size_type i) const {
+        check(i);
+        return (*this)[i];
+    }
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    /* Iterate */
+    iterator begin() noexcept { return iterator(slots()); }
+    iterator end() noexcept { return iterator(slots() + size()); }
+    const_iterator begin() const noexcept { return const_iterator(slots()); }
+    const_iterator end() const noexcept { return const_iterator(slots() + size()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /* Get size */
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept { return list_ ? list_->length : 0; }
+    size_type max_size() const noexcept { return std::numeric_limits<int>::max(); }
+    size_type capacity() const noexcept { return list_ ? list_->capacity : 0; }
+
+    /* Set size */
+    void reserve(size_type n) {
+        if (n > max_size()) {
+            throw std::length_error("arraylist::reserve");
+        }
+        if (n > capacity() && !arraylist_reserve(handle(), static_cast<int>(n))) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /* New elements are value-initialized in place */
+    void resize(size_type n) {
+        while (size() > n) {
+            pop_back();
+        }
+        reserve(n);
+        while (size() < n) {
+            emplace_back();
+        }
+    }
+    void resize(size_type n, const T &value) {
+        while (size() > n) {
+            pop_back();
+        }
+        reserve(n);
+        while (size() < n) {
+            push_back(value);
+        }
+    }
+
+    /* Add/Remove elements */
+    void clear() noexcept {
+        for (size_type i = size(); i > 0; i--) {
+            destroy(list_->array[i - 1]);
+        }
+        if (list_) {
+            arraylist_resize(list_, 0);
+        }
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args &&...args) {
+        const Arraylist list = handle();
+        const int length = list->length;
+        const Value value = create(stored_inline(), std::forward<Args>(args)...);
+
+        /* Inline elements may read as NULL, so failure shows in the length */
+        arraylist_push_back(list, value);
+        if (list->length == length) {
+            destroy(value);
+            throw std::bad_alloc();
+        }
+        return back();
+    }
+
+    void pop_back() {
+        destroy(list_->array[list_->length - 1]);
+        arraylist_resize(list_, list_->length - 1);
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        const int index = static_cast<int>(pos.slot() - slots());
+        const Arraylist list = handle();
+        const int length = list->length;
+        const Value value = create(stored_inline(), std::forward<Args>(args)...);
+        arraylist_push(list, index, value);
+        if (list->length == length) {
+            destroy(value);
+            throw std::bad_alloc();
+        }
+        return begin() + index;
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last) {
+        const int from = static_cast<int>(first.slot() - slots());
+        const int to = static_cast<int>(last.slot() - slots());
+        for (int i = from; i < to; i++) {
+            destroy(list_->array[i]);
+        }
+
+        /* Pointers shift down, elements stay put */
+        std::copy(list_->array + to, list_->array + list_->length, list_->array + from);
+        if (to > from && list_->index) {
+            list_->index->dirty = true;
+        }
+        if (to > from) {
+            arraylist_resize(list_, list_->length - (to - from));
+        }
+        return begin() + from;
+    }
+
+    void swap(arraylist &other) noexcept {
+        std::swap(list_, other.list_);
+        swap_allocator(other, typename alloc_traits::propagate_on_container_swap());
+    }
+
+    friend void swap(arraylist &a, arraylist &b) noexcept { a.swap(b); }
+
+    friend bool operator==(const arraylist &a, const arraylist &b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator!=(const arraylist &a, const arraylist &b) { return !(a == b); }
+
+private:
+    Arraylist list_;  /* Created on the first insertion */
+    Alloc alloc_;
+
+    Value *slots() const noexcept { return list_ ? list_->array : nullptr; }
+
+    Arraylist handle() {
+        if (list_ == nullptr && (list_ = arraylist_init(0)) == nullptr) {
+            throw std::bad_alloc();
+        }
+        return list_;
+    }
+
+    void check(size_type i) const {
+        if (i >= size()) {
+            throw std::out_of_range("arraylist::at");
+        }
+    }
+
+    /* Element held by a slot */
+    static T *element(Value *slot) noexcept { return element(slot, stored_inline()); }
+    static T *element(Value *slot, std::true_type) noexcept { return reinterpret_cast<T *>(slot); }
+    static T *element(Value *slot, std::false_type) noexcept { return static_cast<T *>(*slot); }
+
+    /* Value holding a new element */
+    template <typename... Args>
+    Value create(std::true_type, Args &&...args) {
+        Value value = nullptr;
+        alloc_traits::construct(alloc_, element(&value), std::forward<Args>(args)...);
+        return value;
+    }
+
+    template <typename... Args>
+    Value create(std::false_type, Args &&...args) {
+        const pointer allocated = alloc_traits::allocate(alloc_, 1);
+        T *element = std::addressof(*allocated);
+        try {
+            alloc_traits::construct(alloc_, element, std::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_, allocated, 1);
+            throw;
+        }
+        return element;
+    }
+
+    /* Inline elements are trivially destructible and own no memory */
+    void destroy(Value value) noexcept { destroy(value, stored_inline()); }
+    void destroy(Value, std::true_type) noexcept {}
+    void destroy(Value value, std::false_type) noexcept {
+        T *element = static_cast<T *>(value);
+        alloc_traits::destroy(alloc_, element);
+        alloc_traits::deallocate(alloc_, std::pointer_traits<pointer>::pointer_to(*element), 1);
+    }
+
+    void swap_contents(arraylist &other) noexcept {
+        std::swap(list_, other.list_);
+        std::swap(alloc_, other.alloc_);
+    }
+
+    void move_allocator(arraylist &other, std::true_type) { alloc_ = std::move(other.alloc_); }
+    void move_allocator(arraylist &, std::false_type) {}
+    void swap_allocator(arraylist &other, std::true_type) { std::swap(alloc_, other.alloc_); }
+    void swap_allocator(arraylist &, std::false_type) {}
+};
+
+}
+
+#endif
@@ -0,0 +1,368 @@
+/**
+ * Implementation file for Arraylist reductions and prefix scans.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "arraylist_parallel.h"
+
+enum ParallelKind { REDUCE, SCAN, SUM, MIN, MAX };
+
+struct ParallelTask {
+    enum ParallelKind kind;
+    ArraylistView view;  /* Elements of this task */
+    Value (*op)(Value, Value, void *);
+    void *context;
+    Value offset;  /* Scan: Value combined in before the first element */
+    bool inclusive;
+    Value partial;  /* Reduce: op over the View's elements */
+    intptr_t number;  /* Built-ins: sum, min or max of the View */
+};
+
+static int split(const Arraylist a, const int threads, struct ParallelTask *tasks);
+static void run_all(struct ParallelTask *tasks, const int n);
+static void *run_task(void *task);
+static Value scan_view(const ArraylistView v, Value offset, Value (*op)(Value, Value, void *), void *context, const bool inclusive);
+static intptr_t builtin(const Arraylist a, const int threads, const enum ParallelKind kind);
+
+/**
+ * Combine every element of an Arraylist with op, left to right,
+ * starting from init.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const Value init: Value to start from, returned for an empty Arraylist.
+ *     Value (*op)(Value, Value, void *): Combines an accumulated Value
+ *                                        with the next element.
+ *     void *context: Passed to op.
+ * Returns:
+ *     Value: op(...op(op(init, a[0]), a[1])..., a[length - 1]).
+*/
+Value arraylist_reduce(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context) {
+    Value accumulated = init;
+    for (int i = 0; i < a->length; i++) {
+        accumulated = op(accumulated, a->array[i], context);
+    }
+    return accumulated;
+}
+
+/**
+ * Combine every element of an Arraylist with an associative op across
+ * threads.  Each thread reduces one contiguous part, and the partials are
+ * combined in order starting from init.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist to use.
+ *     const Value init: Value to start from, returned for an empty Arraylist.
+ *     Value (*op)(Value, Value, void *): Associative, thread-safe op.
+ *     void *context: Passed to op.
+ *     const int threads: Most threads to use, including the caller's.
+ * Returns:
+ *     Value: The same result as arraylist_reduce.
+*/
+Value arraylist_reduce_parallel(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context, const int threads) {
+    struct ParallelTask tasks[ARRAYLIST_PARALLEL_MAX_THREADS];
+    const int n = split(a, threads, tasks);
+    if (n < 2) {
+        return arraylist_reduce(a, init, op, context);
+    }
+
+    for (int i = 0; i < n; i++) {
+        tasks[i].kind = REDUCE;
+        tasks[i].op = op;
+        tasks[i].context = context;
+    }
+    run_all(tasks, n);
+
+    /* Combine partials in order */
+    Value accumulated = init;
+    for (int i = 0; i < n; i++) {
+        accumulated = op(accumulated, tasks[i].partial, context);
+    }
+    return accumulated;
+}
+
+/**
+ * Replace each element of an Arraylist with the running combination of
+ * the elements up to it, starting from init.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist to change.
+ *     const Value init: Value to start from.
+ *     Value (*op)(Value, Value, void *): Combines an accumulated Value
+ *                                        with the next element.
+ *     void *context: Passed to op.
+ *     const bool inclusive: Whether element i includes itself, otherwise
+ *                           element 0 becomes init.
+ * Returns:
+ *     Arraylist: a.
+*/
+Arraylist arraylist_scan(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context, const bool inclusive) {
+    if (a->length && a->index) {
+        a->index->dirty = true;
+    }
+    scan_view(arraylist_view(a, 0, a->length, 1), init, op, context, inclusive);
+    return a;
+}
+
+/**
+ * Replace each element of an Arraylist with the running combination of
+ * an associative op across threads.  Threads first reduce their parts,
+ * the caller turns the partials into per-part offsets, and threads then
+ * scan their parts from those offsets.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist to change.
+ *     const Value init: Value to start from.
+ *     Value (*op)(Value, Value, void *): Associative, thread-safe op.
+ *     void *context: Passed to op.
+ *     const bool inclusive: Whether element i includes itself, otherwise
+ *                           element 0 becomes init.
+ *     const int threads: Most threads to use, including the caller's.
+ * Returns:
+ *     Arraylist: a.
+*/
+Arraylist arraylist_scan_parallel(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context, const bool inclusive, const int threads) {
+    struct ParallelTask tasks[ARRAYLIST_PARALLEL_MAX_THREADS];
+    const int n = split(a, threads, tasks);
+    if (n < 2) {
+        return arraylist_scan(a, init, op, context, inclusive);
+    }
+    if (a->index) {
+        a->index->dirty = true;
+    }
+
+    /* Partials */
+    for (int i = 0; i < n; i++) {
+        tasks[i].kind = REDUCE;
+        tasks[i].op = op;
+        tasks[i].context = context;
+        tasks[i].inclusive = inclusive;
+    }
+    run_all(tasks, n);
+
+    /* Offsets, then scan each part from its offset */
+    Value offset = init;
+    for (int i = 0; i < n; i++) {
+        tasks[i].kind = SCAN;
+        tasks[i].offset = offset;
+        offset = op(offset, tasks[i].partial, context);
+    }
+    run_all(tasks, n);
+    return a;
+}
+
+/**
+ * Sum the elements of an Arraylist as intptr_t, wrapping on overflow.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist of inline integers to use.
+ *     const int threads: Most threads to use, including the caller's.
+ * Returns:
+ *     intptr_t: 0 if the Arraylist is empty,
+ *               sum of the elements otherwise.
+*/
+intptr_t arraylist_sum_intptr(const Arraylist a, const int threads) {
+    return builtin(a, threads, SUM);
+}
+
+/**
+ * Get the smallest element of an Arraylist as intptr_t.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist of inline integers to use.
+ *     const int threads: Most threads to use, including the caller's.
+ * Returns:
+ *     intptr_t: INTPTR_MAX if the Arraylist is empty,
+ *               smallest element otherwise.
+*/
+intptr_t arraylist_min_intptr(const Arraylist a, const int threads) {
+    return builtin(a, threads, MIN);
+}
+
+/**
+ * Get the largest element of an Arraylist as intptr_t.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist of inline integers to use.
+ *     const int threads: Most threads to use, including the caller's.
+ * Returns:
+ *     intptr_t: INTPTR_MIN if the Arraylist is empty,
+ *               largest element otherwise.
+*/
+intptr_t arraylist_max_intptr(const Arraylist a, const int threads) {
+    return builtin(a, threads, MAX);
+}
+
+/**
+ * Split an Arraylist into one View per task, with at most the given
+ * threads and at least ARRAYLIST_PARALLEL_MIN_GRAIN elements per task.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist to split.
+ *     const int threads: Most tasks to create.
+ *     struct ParallelTask *tasks: Array of ARRAYLIST_PARALLEL_MAX_THREADS
+ *                                 tasks whose Views are set.
+ * Returns:
+ *     int: Number of tasks, at least 1.
+*/
+static int split(const Arraylist a, const int threads, struct ParallelTask *tasks) {
+    int n = (threads < ARRAYLIST_PARALLEL_MAX_THREADS) ? threads : ARRAYLIST_PARALLEL_MAX_THREADS;
+    if (n > a->length / ARRAYLIST_PARALLEL_MIN_GRAIN) {
+        n = a->length / ARRAYLIST_PARALLEL_MIN_GRAIN;
+    }
+    if (n < 1) {
+        n = 1;
+    }
+
+    ArraylistView views[ARRAYLIST_PARALLEL_MAX_THREADS];
+    arraylist_view_split(arraylist_view(a, 0, a->length, 1), n, views);
+    for (int i = 0; i < n; i++) {
+        tasks[i].view = views[i];
+    }
+    return n;
+}
+
+/**
+ * Run tasks on their own threads, the first on the calling thread.
+ * A task whose thread cannot be created runs on the calling thread.
+ *
+ * Inputs:
+ *     struct ParallelTask *tasks: Tasks to run.
+ *     const int n: Length of tasks.
+ * Returns:
+ *     Nothing.
+*/
+static void run_all(struct ParallelTask *tasks, const int n) {
+    pthread_t workers[ARRAYLIST_PARALLEL_MAX_THREADS];
+    bool started[ARRAYLIST_PARALLEL_MAX_THREADS];
+    for (int i = 1; i < n; i++) {
+        started[i] = pthread_create(&workers[i], NULL, run_task, &tasks[i]) == 0;
+    }
+
+    run_task(&tasks[0]);
+    for (int i = 1; i < n; i++) {
+        if (started[i]) {
+            pthread_join(workers[i], NULL);
+        } else {
+            run_task(&tasks[i]);
+        }
+    }
+}
+
+/**
+ * Run one task over its View.  The numeric loops read Values as
+ * integers with no calls or branches, so they vectorize.
+ *
+ * Inputs:
+ *     void *task: struct ParallelTask to run.
+ * Returns:
+ *     void *: NULL.
+*/
+static void *run_task(void *task) {
+    struct ParallelTask *t = task;
+    const Value *array = t->view.array;
+    const int length = t->view.length;
+
+    switch (t->kind) {
+        case REDUCE: {
+            /* Parts are never empty, so start from the first element */
+            Value accumulated = array[0];
+            for (int i = 1; i < length; i++) {
+                accumulated = t->op(accumulated, array[i], t->context);
+            }
+            t->partial = accumulated;
+            break;
+        }
+        case SCAN:
+            scan_view(t->view, t->offset, t->op, t->context, t->inclusive);
+            break;
+        case SUM: {
+            uintptr_t sum = 0;
+            for (int i = 0; i < length; i++) {
+                sum += (uintptr_t)array[i];
+            }
+            t->number = (intptr_t)sum;
+            break;
+        }
+        case MIN: {
+            intptr_t min = INTPTR_MAX;
+            for (int i = 0; i < length; i++) {
+                const intptr_t number = (intptr_t)array[i];
+                min = (number < min) ? number : min;
+            }
+            t->number = min;
+            break;
+        }
+        case MAX: {
+            intptr_t max = INTPTR_MIN;
+            for (int i = 0; i < length; i++) {
+                const intptr_t number = (intptr_t)array[i];
+                max = (number > max) ? number : max;
+            }
+            t->number = max;
+            break;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Scan a contiguous View in place, starting from an offset.
+ *
+ * Inputs:
+ *     const ArraylistView v: View to change.
+ *     Value offset: Value combined in before the first element.
+ *     Value (*op)(Value, Value, void *): Combines an accumulated Value
+ *                                        with the next element.
+ *     void *context: Passed to op.
+ *     const bool inclusive: Whether element i includes itself.
+ * Returns:
+ *     Value: The offset for the elements after the View.
+*/
+static Value scan_view(const ArraylistView v, Value offset, Value (*op)(Value, Value, void *), void *context, const bool inclusive) {
+    for (int i = 0; i < v.length; i++) {
+        const Value element = v.array[i];
+        if (inclusive) {
+            offset = op(offset, element, context);
+            v.array[i] = offset;
+        } else {
+            v.array[i] = offset;
+            offset = op(offset, element, context);
+        }
+    }
+    return offset;
+}
+
+/**
+ * Compute a numeric built-in across threads and combine the partials.
+ *
+ * Inputs:
+ *     const Arraylist a: Arraylist of inline integers to use.
+ *     const int threads: Most threads to use, including the caller's.
+ *     const enum ParallelKind kind: SUM, MIN or MAX.
+ * Returns:
+ *     intptr_t: The combined result.
+*/
+static intptr_t builtin(const Arraylist a, const int threads, const enum ParallelKind kind) {
+    struct ParallelTask tasks[ARRAYLIST_PARALLEL_MAX_THREADS];
+    const int n = split(a, threads, tasks);
+    for (int i = 0; i < n; i++) {
+        tasks[i].kind = kind;
+    }
+    run_all(tasks, n);
+
+    intptr_t result = tasks[0].number;
+    for (int i = 1; i < n; i++) {
+        if (kind == SUM) {
+            result = (intptr_t)((uintptr_t)result + (uintptr_t)tasks[i].number);
+        } else if (kind == MIN) {
+            result = (tasks[i].number < result) ? tasks[i].number : result;
+        } else {
+            result = (tasks[i].number > result) ? tasks[i].number : result;
+        }
+    }
+    return result;
+}
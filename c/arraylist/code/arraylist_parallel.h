@@ -0,0 +1,33 @@
+/**
+ * Header file for Arraylist reductions and prefix scans.
+ *
+ * Each operation has a serial form and a parallel form that splits the
+ * Arraylist into one View per thread, computes per-thread partials and
+ * combines them in order, so op must be associative but need not be
+ * commutative.  The intptr built-ins treat Values as inline integers.
+*/
+
+#ifndef ARRAYLIST_PARALLEL_H_
+#define ARRAYLIST_PARALLEL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "arraylist.h"
+
+#define ARRAYLIST_PARALLEL_MAX_THREADS 64
+#define ARRAYLIST_PARALLEL_MIN_GRAIN 4096  /* Fewest elements worth a thread */
+
+/* Reduce */
+Value arraylist_reduce(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context);
+Value arraylist_reduce_parallel(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context, const int threads);
+
+/* Scan */
+Arraylist arraylist_scan(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context, const bool inclusive);
+Arraylist arraylist_scan_parallel(const Arraylist a, const Value init, Value (*op)(Value, Value, void *), void *context, const bool inclusive, const int threads);
+
+/* Inline integer built-ins */
+intptr_t arraylist_sum_intptr(const Arraylist a, const int threads);
+intptr_t arraylist_min_intptr(const Arraylist a, const int threads);
+intptr_t arraylist_max_intptr(const Arraylist a, const int threads);
+
+#endif
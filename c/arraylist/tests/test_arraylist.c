@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <limits.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include "../code/arraylist.h"
@@ -355,14 +356,29 @@ void test_arraylist_set() {
  * Case index past length.
  * Case index past capacity.
  * Case default (index within length).
+ * Case later values shift back.
 */
 void test_arraylist_push() {
     int value = 7;
+    int others[] = { 1, 2, 3 };
     const Arraylist inputs[] = {
         arraylist_init(0),
         arraylist_init(0),
         arraylist_init(0),
         arraylist_init(5),
+        memcpy(
+            malloc(sizeof(struct Arraylist)),
+            &(struct Arraylist){
+                3,
+                10,
+                memcpy(
+                    malloc(10 * sizeof(Value)),
+                    &(Value[]){ &others[0], &others[1], &others[2], NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+                    10 * sizeof(Value)
+                )
+            },
+            sizeof(struct Arraylist)
+        ),
     };
     const Arraylist outputs[] = {
         memcpy(
@@ -413,12 +429,26 @@ void test_arraylist_push() {
             },
             sizeof(struct Arraylist)
         ),
+        memcpy(
+            malloc(sizeof(struct Arraylist)),
+            &(struct Arraylist){
+                4,
+                10,
+                memcpy(
+                    malloc(10 * sizeof(Value)),
+                    &(Value[]){ &others[0], &value, &others[1], &others[2], NULL, NULL, NULL, NULL, NULL, NULL },
+                    10 * sizeof(Value)
+                )
+            },
+            sizeof(struct Arraylist)
+        ),
     };
     const TestValue tests[] = {
         { arraylist_push(inputs[0], -1, &value), NULL },
         { arraylist_push(inputs[1], 3, &value), &value },
         { arraylist_push(inputs[2], 10, &value), &value },
         { arraylist_push(inputs[3], 3, &value), &value },
+        { arraylist_push(inputs[4], 1, &value), &value },
     };
 
     const int num_tests = sizeof(tests) / sizeof(*tests);
@@ -436,6 +466,45 @@ void test_arraylist_push() {
     }
 }
 
+/**
+ * Case appends into spare capacity, then grows.
+ * Case appends with the index enabled.
+ * Case grows at the same fill ratio as push.
+*/
+void test_arraylist_push_back() {
+    int values[100];
+    const Arraylist inputs[] = {
+        arraylist_init(0),
+        arraylist_index_enable(arraylist_init(0)),
+    };
+    const Arraylist pushed = arraylist_init(0);
+
+    /* Test */
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 100; j++) {
+            assert_value(arraylist_push_back(inputs[i], &values[j]), &values[j]);
+            assert_int(arraylist_length(inputs[i]), j + 1);
+            if (i == 0) {
+                arraylist_push(pushed, j, &values[j]);
+                assert_int(arraylist_capacity(inputs[i]), arraylist_capacity(pushed));
+            }
+        }
+        for (int j = 0; j < 100; j++) {
+            assert_value(arraylist_get(inputs[i], j), &values[j]);
+            assert_value(arraylist_get_unchecked(inputs[i], j), &values[j]);
+        }
+        assert_value(arraylist_get(inputs[i], 100), NULL);
+        assert_value(arraylist_get(inputs[i], -1), NULL);
+    }
+    assert_int(arraylist_index_of(inputs[1], &values[42]), 42);
+
+    /* Free */
+    for (int i = 0; i < 2; i++) {
+        arraylist_free(inputs[i]);
+    }
+    arraylist_free(pushed);
+}
+
 /**
  * Case default.
 */
@@ -598,6 +667,382 @@ void test_arraylist_resize() {
     }
 }
 
+/**
+ * Case growing again within capacity reads NULL in dropped elements.
+ * Case growing again past capacity keeps elements and reads NULL in dropped ones.
+*/
+void test_arraylist_resize_regrow() {
+    int values[] = { 0, 1, 2, 3, 4, 5 };
+    const Arraylist input = arraylist_init(0);
+    for (int i = 0; i < 6; i++) {
+        arraylist_set(input, i, &values[i]);
+    }
+
+    /* Test */
+    assert(arraylist_resize(input, 2) == input);
+    assert(arraylist_resize(input, 6) == input);
+    assert_value(input->array[1], &values[1]);
+    for (int i = 2; i < 6; i++) {
+        assert_value(arraylist_get(input, i), NULL);
+    }
+    arraylist_set(input, 5, &values[5]);
+    assert(arraylist_pop(input, 5) == &values[5]);
+    assert(arraylist_resize(input, 100) == input);
+    assert_value(input->array[1], &values[1]);
+    for (int i = 2; i < 100; i++) {
+        assert_value(arraylist_get(input, i), NULL);
+    }
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case capacity is negative.
+ * Case new capacity is lower than old capacity.
+ * Case new capacity is higher than old capacity keeps elements.
+*/
+void test_arraylist_reserve_uninit() {
+    int value = 7;
+    const Arraylist inputs[] = {
+        arraylist_init(0),
+        arraylist_init(10),
+        arraylist_init(6),
+    };
+    arraylist_set(inputs[2], 5, &value);
+
+    /* Test */
+    assert(arraylist_reserve_uninit(inputs[0], -1) == NULL);
+    assert(arraylist_reserve_uninit(inputs[1], 2) == inputs[1]);
+    assert_int(inputs[1]->length, 2);
+    assert_int(inputs[1]->capacity, 2);
+    assert(arraylist_reserve_uninit(inputs[2], 1000) == inputs[2]);
+    assert_int(inputs[2]->length, 6);
+    assert_int(inputs[2]->capacity, 1000);
+    assert_value(inputs[2]->array[5], &value);
+
+    /* Free */
+    for (int i = 0; i < 3; i++) {
+        arraylist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case length is negative.
+ * Case capacity grows and keeps elements.
+ * Case spare capacity and dropped elements read as NULL.
+ * Case capacity shrinks.
+*/
+void test_arraylist_resize_for_overwrite() {
+    int value = 7;
+    const Arraylist input = arraylist_init(0);
+    arraylist_set(input, 3, &value);
+
+    /* Test */
+    assert(arraylist_resize_for_overwrite(input, -1) == NULL);
+    assert(arraylist_resize_for_overwrite(input, 100) == input);
+    assert_int(input->length, 100);
+    assert_int(input->capacity, 200);
+    assert_value(input->array[3], &value);
+    for (int i = 4; i < 100; i++) {
+        input->array[i] = &value;
+    }
+    assert_value(arraylist_get(input, 99), &value);
+    assert_value(arraylist_set(input, 150, &value), &value);
+    for (int i = 100; i < 150; i++) {
+        assert_value(arraylist_get(input, i), NULL);
+    }
+    assert(arraylist_resize_for_overwrite(input, 50) == input);
+    assert(arraylist_resize_for_overwrite(input, 60) == input);
+    assert_value(input->array[55], NULL);
+    assert(arraylist_resize_for_overwrite(input, 0) == input);
+    assert_int(input->capacity, 10);
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case resize, push_back and resize_for_overwrite grow past a fresh page
+ * allocation, keeping elements and zeroing the rest.
+*/
+void test_arraylist_resize_large() {
+    int value = 7;
+    const int length = 1 << 18;
+    const Arraylist input = arraylist_init(0);
+    const Arraylist pushed = arraylist_init(0);
+    arraylist_set(input, 2, &value);
+
+    /* Test */
+    assert(arraylist_resize(input, length) == input);
+    assert_int(input->length, length);
+    assert_value(input->array[2], &value);
+    for (int i = 3; i < input->capacity; i++) {
+        assert_value(input->array[i], NULL);
+    }
+    for (int i = 0; i < length; i++) {
+        assert_value(arraylist_push_back(pushed, (Value)(intptr_t)(i + 1)), (Value)(intptr_t)(i + 1));
+    }
+    assert_int(pushed->length, length);
+    for (int i = 0; i < length; i++) {
+        assert_value(pushed->array[i], (Value)(intptr_t)(i + 1));
+    }
+    assert(arraylist_resize_for_overwrite(pushed, 4 * length) == pushed);
+    assert_value(pushed->array[length - 1], (Value)(intptr_t)length);
+    for (int i = 4 * length; i < pushed->capacity; i++) {
+        assert_value(pushed->array[i], NULL);
+    }
+
+    /* Free */
+    arraylist_free(input);
+    arraylist_free(pushed);
+}
+
+/**
+ * Case large growth is zeroed and keeps elements.
+*/
+void test_arraylist_reserve_large() {
+    int value = 7;
+    const int capacity = 1 << 20;
+    const Arraylist input = arraylist_init(3);
+    arraylist_set(input, 2, &value);
+
+    /* Test */
+    assert(arraylist_reserve(input, capacity) == input);
+    assert_int(input->length, 3);
+    assert_int(input->capacity, capacity);
+    assert_value(input->array[2], &value);
+    for (int i = 3; i < capacity; i++) {
+        assert_value(input->array[i], NULL);
+    }
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case no index (scan).
+ * Case Value or NULL not present.
+ * Case index follows set, push and pop at the end.
+ * Case index rebuilt after shifting push and pop.
+ * Case duplicates return the lowest index.
+ * Case duplicates share one entry, which follows overwrites of the lowest.
+ * Case alternately overwriting and restoring the lowest copy (the documented
+ * O(length) lookup) still finds the far copy each time.
+*/
+void test_arraylist_index_of() {
+    int values[] = { 0, 1, 2, 3 };
+    const Arraylist input = arraylist_init(0);
+    for (int i = 0; i < 3; i++) {
+        arraylist_set(input, i, &values[i]);
+    }
+
+    /* Test */
+    assert_int(arraylist_index_of(input, &values[2]), 2);
+    assert(arraylist_index_enable(input) == input);
+    assert_int(arraylist_index_of(input, &values[3]), -1);
+    assert_int(arraylist_index_of(input, NULL), -1);
+    assert_int(arraylist_index_of(input, &values[1]), 1);
+
+    arraylist_set(input, 1, &values[3]);
+    arraylist_push(input, 3, &values[1]);
+    assert_int(arraylist_index_of(input, &values[3]), 1);
+    assert_int(arraylist_index_of(input, &values[1]), 3);
+    assert(!input->index->dirty);
+    arraylist_pop(input, 3);
+    assert_int(arraylist_index_of(input, &values[1]), -1);
+    assert(!input->index->dirty);
+
+    arraylist_push(input, 0, &values[1]);
+    assert(input->index->dirty);
+    assert_int(arraylist_index_of(input, &values[0]), 1);
+    assert_int(arraylist_index_of(input, &values[2]), 3);
+    arraylist_pop(input, 0);
+    assert_int(arraylist_index_of(input, &values[0]), 0);
+
+    arraylist_set(input, 5, &values[0]);
+    assert_int(arraylist_index_of(input, NULL), 3);
+    arraylist_set(input, 0, NULL);
+    assert_int(arraylist_index_of(input, &values[0]), 5);
+
+    for (int i = 0; i < 1000; i++) {
+        arraylist_push(input, input->length, &values[i % 4]);
+    }
+    assert_int(arraylist_index_of(input, &values[0]), 5);
+    assert_int(input->index->count, 4);
+    arraylist_set(input, 5, &values[1]);
+    assert_int(arraylist_index_of(input, &values[0]), 6);
+    arraylist_set(input, 4, &values[0]);
+    assert_int(arraylist_index_of(input, &values[0]), 4);
+    while (input->length > 8) {
+        arraylist_pop(input, input->length - 1);
+    }
+    assert(!input->index->dirty);
+    assert_int(arraylist_index_of(input, &values[0]), 4);
+    assert_int(arraylist_index_of(input, &values[3]), 1);
+    arraylist_set(input, 1, NULL);
+    assert_int(arraylist_index_of(input, &values[3]), -1);
+    assert_int(input->index->count, 3);
+    arraylist_clear(input);
+    assert_int(arraylist_index_of(input, &values[0]), -1);
+
+    arraylist_set(input, 0, &values[2]);
+    arraylist_set(input, 999, &values[2]);
+    for (int i = 0; i < 3; i++) {
+        arraylist_set(input, 0, &values[1]);
+        assert_int(arraylist_index_of(input, &values[2]), 999);
+        arraylist_set(input, 0, &values[2]);
+        assert_int(arraylist_index_of(input, &values[2]), 0);
+    }
+    assert(!input->index->dirty);
+
+    arraylist_index_disable(input);
+    assert(input->index == NULL);
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case append another Arraylist.
+ * Case append an Arraylist to itself.
+ * Case appended elements are found through the index.
+*/
+void test_arraylist_concat() {
+    int values[6];
+    const Arraylist dst = arraylist_index_enable(arraylist_init(0));
+    const Arraylist src = arraylist_init(0);
+    for (int i = 0; i < 3; i++) {
+        arraylist_push_back(dst, &values[i]);
+        arraylist_push_back(src, &values[i + 3]);
+    }
+
+    /* Test */
+    assert(arraylist_concat(dst, src) == dst);
+    assert_int(arraylist_length(dst), 6);
+    assert_int(arraylist_length(src), 3);
+    for (int i = 0; i < 6; i++) {
+        assert_value(arraylist_get(dst, i), &values[i]);
+    }
+    assert_int(arraylist_index_of(dst, &values[4]), 4);
+    assert(arraylist_concat(src, src) == src);
+    assert_int(arraylist_length(src), 6);
+    assert_value(arraylist_get(src, 5), &values[5]);
+    assert_value(arraylist_get(src, 2), &values[5]);
+
+    /* Free */
+    arraylist_free(dst);
+    arraylist_free(src);
+}
+
+/**
+ * Case move a middle range into the middle.
+ * Case move a trailing range to the end.
+ * Case invalid ranges and same Arraylist.
+*/
+void test_arraylist_splice() {
+    int values[10];
+    const Arraylist dst = arraylist_init(0);
+    const Arraylist src = arraylist_index_enable(arraylist_init(0));
+    for (int i = 0; i < 4; i++) {
+        arraylist_push_back(dst, &values[i]);
+    }
+    for (int i = 4; i < 10; i++) {
+        arraylist_push_back(src, &values[i]);
+    }
+
+    /* Test */
+    assert(arraylist_splice(dst, 2, src, 1, 3) == dst);
+    const int dst_order[] = { 0, 1, 5, 6, 2, 3 };
+    assert_int(arraylist_length(dst), 6);
+    for (int i = 0; i < 6; i++) {
+        assert_value(arraylist_get(dst, i), &values[dst_order[i]]);
+    }
+    const int src_order[] = { 4, 7, 8, 9 };
+    assert_int(arraylist_length(src), 4);
+    for (int i = 0; i < 4; i++) {
+        assert_value(arraylist_get(src, i), &values[src_order[i]]);
+    }
+    assert_int(arraylist_index_of(src, &values[7]), 1);
+    assert_int(arraylist_index_of(src, &values[5]), -1);
+    assert(arraylist_splice(dst, 6, src, 2, 4) == dst);
+    assert_int(arraylist_length(dst), 8);
+    assert_value(arraylist_get(dst, 7), &values[9]);
+    assert_int(arraylist_length(src), 2);
+    assert_int(arraylist_index_of(src, &values[8]), -1);
+    assert(arraylist_splice(dst, 9, src, 0, 1) == NULL);
+    assert(arraylist_splice(dst, 0, src, 1, 3) == NULL);
+    assert(arraylist_splice(dst, 0, src, 2, 1) == NULL);
+    assert(arraylist_splice(dst, 0, dst, 0, 1) == NULL);
+
+    /* Free */
+    arraylist_free(dst);
+    arraylist_free(src);
+}
+
+/**
+ * Case contents, capacities and indices are exchanged.
+*/
+void test_arraylist_swap() {
+    int value;
+    const Arraylist a = arraylist_init(3);
+    const Arraylist b = arraylist_index_enable(arraylist_init(40));
+    arraylist_set(b, 39, &value);
+
+    /* Test */
+    arraylist_swap(a, b);
+    assert_int(arraylist_length(a), 40);
+    assert_int(arraylist_length(b), 3);
+    assert_value(arraylist_get(a, 39), &value);
+    assert(a->index != NULL && b->index == NULL);
+    assert_int(arraylist_index_of(a, &value), 39);
+
+    /* Free */
+    arraylist_free(a);
+    arraylist_free(b);
+}
+
+/**
+ * Case take leaves an empty Arraylist.
+ * Case adopt takes a buffer without copying.
+ * Case invalid buffers.
+*/
+void test_arraylist_take_adopt_buffer() {
+    int values[5];
+    int length = -1;
+    int capacity = -1;
+    const Arraylist a = arraylist_index_enable(arraylist_init(0));
+    const Arraylist b = arraylist_init(0);
+    for (int i = 0; i < 5; i++) {
+        arraylist_push_back(a, &values[i]);
+    }
+    const Value *original = a->array;
+
+    /* Test */
+    Value *array = arraylist_take_buffer(a, &length, &capacity);
+    assert(array == original);
+    assert_int(length, 5);
+    assert_int(capacity, 10);
+    assert(arraylist_empty(a));
+    assert_int(arraylist_index_of(a, &values[0]), -1);
+    assert_value(arraylist_push_back(a, &values[0]), &values[0]);
+    assert(arraylist_adopt_buffer(b, array, 3, capacity) == b);
+    assert(b->array == original);
+    assert_int(arraylist_length(b), 3);
+    assert_value(arraylist_get(b, 2), &values[2]);
+    arraylist_set(b, 4, &values[0]);
+    assert_value(arraylist_get(b, 3), NULL);
+    assert(arraylist_adopt_buffer(b, NULL, 0, 1) == NULL);
+    assert(arraylist_adopt_buffer(b, b->array, 0, 1) == NULL);
+    Value *invalid = malloc(sizeof(Value));
+    assert(arraylist_adopt_buffer(b, invalid, 2, 1) == NULL);
+
+    /* Free */
+    free(invalid);
+    arraylist_free(a);
+    arraylist_free(b);
+}
+
 /**
  * Case default.
 */
@@ -660,6 +1105,212 @@ void test_arraylist_map() {
     }
 }
 
+/**
+ * Case distance shorter than the Arraylist.
+ * Case distance longer than the Arraylist.
+ * Case default distance.
+*/
+int prefetch_sum = 0;
+void prefetch_fn(Value input) {
+    prefetch_sum += *(int *)input;
+}
+void test_arraylist_foreach_prefetch() {
+    int values[100];
+    const Arraylist input = arraylist_init(100);
+    for (int i = 0; i < 100; i++) {
+        values[i] = i;
+        arraylist_set(input, i, &values[i]);
+    }
+
+    /* Test */
+    const int distances[] = { 4, 1000, 0 };
+    for (int i = 0; i < 3; i++) {
+        prefetch_sum = 0;
+        arraylist_foreach_prefetch(input, prefetch_fn, distances[i]);
+        assert_int(prefetch_sum, 4950);
+    }
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case scattered indices, for short, long and default distances.
+ * Case invalid index.
+ * Case no indices.
+*/
+void test_arraylist_get_many() {
+    int values[50];
+    Value out[20];
+    int indices[20];
+    const Arraylist input = arraylist_init(50);
+    for (int i = 0; i < 50; i++) {
+        arraylist_set(input, i, &values[i]);
+    }
+    for (int i = 0; i < 20; i++) {
+        indices[i] = (i * 17) % 50;
+    }
+
+    /* Test */
+    const int distances[] = { 2, 1000, 0 };
+    for (int d = 0; d < 3; d++) {
+        assert(arraylist_get_many(input, indices, 20, out, distances[d]) == out);
+        for (int i = 0; i < 20; i++) {
+            assert_value(out[i], &values[indices[i]]);
+        }
+    }
+    indices[3] = 50;
+    assert(arraylist_get_many(input, indices, 20, out, 0) == NULL);
+    assert_value(out[3], NULL);
+    assert_value(out[4], &values[indices[4]]);
+    assert(arraylist_get_many(input, indices, 0, out, 0) == out);
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case contiguous range.
+ * Case strided range with a partial last stride.
+ * Case invalid ranges and stride.
+*/
+void test_arraylist_view() {
+    int values[10];
+    const Arraylist input = arraylist_init(10);
+    for (int i = 0; i < 10; i++) {
+        arraylist_set(input, i, &values[i]);
+    }
+
+    /* Test */
+    const ArraylistView contiguous = arraylist_view(input, 2, 6, 1);
+    assert_int(contiguous.length, 4);
+    assert_value(arraylist_view_get(contiguous, 0), &values[2]);
+    assert_value(arraylist_view_get(contiguous, 3), &values[5]);
+    assert_value(arraylist_view_get(contiguous, 4), NULL);
+    const ArraylistView strided = arraylist_view(input, 1, 10, 3);
+    assert_int(strided.length, 3);
+    assert_value(arraylist_view_get(strided, 2), &values[7]);
+    assert(arraylist_view(input, -1, 5, 1).array == NULL);
+    assert(arraylist_view(input, 0, 11, 1).array == NULL);
+    assert(arraylist_view(input, 6, 5, 1).array == NULL);
+    assert(arraylist_view(input, 0, 5, 0).array == NULL);
+    assert_int(arraylist_view(input, 5, 5, 1).length, 0);
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case foreach, map and search over a strided View.
+ * Case map marks the index for rebuilding.
+*/
+int view_sum = 0;
+void view_sum_fn(Value value) {
+    view_sum += *(int *)value;
+}
+int view_mapped = -1;
+Value view_map_fn(Value value) {
+    return &view_mapped;
+}
+void test_arraylist_view_foreach_map() {
+    int values[10];
+    const Arraylist input = arraylist_index_enable(arraylist_init(10));
+    for (int i = 0; i < 10; i++) {
+        values[i] = i;
+        arraylist_set(input, i, &values[i]);
+    }
+    const ArraylistView even = arraylist_view(input, 0, 10, 2);
+
+    /* Test */
+    view_sum = 0;
+    arraylist_view_foreach(even, view_sum_fn);
+    assert_int(view_sum, 20);
+    assert_int(arraylist_view_index_of(even, &values[6]), 3);
+    assert_int(arraylist_view_index_of(even, &values[7]), -1);
+    arraylist_view_map(even, view_map_fn);
+    for (int i = 0; i < 10; i++) {
+        assert_value(arraylist_get(input, i), (i % 2) ? &values[i] : &view_mapped);
+    }
+    assert_int(arraylist_index_of(input, &view_mapped), 0);
+    assert_int(arraylist_index_of(input, &values[4]), -1);
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case uneven split covers every element once.
+ * Case more parts than elements.
+ * Case no parts.
+*/
+void test_arraylist_view_split() {
+    int values[10];
+    ArraylistView parts[4];
+    const Arraylist input = arraylist_init(10);
+    for (int i = 0; i < 10; i++) {
+        arraylist_set(input, i, &values[i]);
+    }
+
+    /* Test */
+    assert_int(arraylist_view_split(arraylist_view(input, 0, 10, 1), 4, parts), 4);
+    const int lengths[] = { 3, 3, 2, 2 };
+    for (int i = 0, next = 0; i < 4; i++) {
+        assert_int(parts[i].length, lengths[i]);
+        for (int j = 0; j < parts[i].length; j++, next++) {
+            assert_value(arraylist_view_get(parts[i], j), &values[next]);
+        }
+    }
+    assert_int(arraylist_view_split(arraylist_view(input, 1, 4, 2), 4, parts), 4);
+    assert_value(arraylist_view_get(parts[0], 0), &values[1]);
+    assert_value(arraylist_view_get(parts[1], 0), &values[3]);
+    assert_int(parts[2].length + parts[3].length, 0);
+    assert_int(arraylist_view_split(arraylist_view(input, 0, 10, 1), 0, parts), -1);
+
+    /* Free */
+    arraylist_free(input);
+}
+
+/**
+ * Case disabled by default, nothing is retained.
+ * Case freed header and buffer are reused.
+ * Case retained memory stays within the limit and trims.
+ * Case disable frees everything.
+*/
+void test_arraylist_pool() {
+    int value;
+
+    /* Test */
+    arraylist_free(arraylist_init(5));
+    assert_int(arraylist_pool_retained(), 0);
+
+    arraylist_pool_enable(1 << 20);
+    Arraylist a = arraylist_init(100);
+    const Arraylist header = a;
+    const Value *buffer = a->array;
+    arraylist_set(a, 7, &value);
+    arraylist_free(a);
+    assert(arraylist_pool_retained() == sizeof(struct Arraylist) + 200 * sizeof(Value));
+    a = arraylist_init(60);
+    assert(a == header);
+    assert(a->array == buffer);
+    assert_int(arraylist_length(a), 60);
+    assert_int(arraylist_capacity(a), 200);
+    assert_value(arraylist_get(a, 7), NULL);
+    assert_int(arraylist_pool_retained(), 0);
+    arraylist_free(a);
+
+    /* Too large to retain */
+    arraylist_free(arraylist_init(1 << 18));
+    assert(arraylist_pool_retained() <= 1 << 20);
+    arraylist_pool_trim(sizeof(struct Arraylist));
+    assert(arraylist_pool_retained() <= sizeof(struct Arraylist));
+
+    arraylist_pool_disable();
+    assert_int(arraylist_pool_retained(), 0);
+    arraylist_free(arraylist_init(5));
+    assert_int(arraylist_pool_retained(), 0);
+}
+
 const UnitTest TESTS[] = {
     { test_arraylist_init, "test_arraylist_init" },
     { test_arraylist_empty, "test_arraylist_empty" },
@@ -668,12 +1319,29 @@ const UnitTest TESTS[] = {
     { test_arraylist_pop, "test_arraylist_pop" },
     { test_arraylist_set, "test_arraylist_set" },
     { test_arraylist_push, "test_arraylist_push" },
+    { test_arraylist_push_back, "test_arraylist_push_back" },
     { test_arraylist_length, "test_arraylist_length" },
     { test_arraylist_capacity, "test_arraylist_capacity" },
     { test_arraylist_reserve, "test_arraylist_reserve" },
     { test_arraylist_resize, "test_arraylist_resize" },
+    { test_arraylist_resize_regrow, "test_arraylist_resize_regrow" },
+    { test_arraylist_reserve_uninit, "test_arraylist_reserve_uninit" },
+    { test_arraylist_resize_for_overwrite, "test_arraylist_resize_for_overwrite" },
+    { test_arraylist_resize_large, "test_arraylist_resize_large" },
+    { test_arraylist_reserve_large, "test_arraylist_reserve_large" },
+    { test_arraylist_concat, "test_arraylist_concat" },
+    { test_arraylist_splice, "test_arraylist_splice" },
+    { test_arraylist_swap, "test_arraylist_swap" },
+    { test_arraylist_take_adopt_buffer, "test_arraylist_take_adopt_buffer" },
     { test_arraylist_foreach, "test_arraylist_foreach" },
     { test_arraylist_map, "test_arraylist_map" },
+    { test_arraylist_foreach_prefetch, "test_arraylist_foreach_prefetch" },
+    { test_arraylist_get_many, "test_arraylist_get_many" },
+    { test_arraylist_index_of, "test_arraylist_index_of" },
+    { test_arraylist_view, "test_arraylist_view" },
+    { test_arraylist_view_foreach_map, "test_arraylist_view_foreach_map" },
+    { test_arraylist_view_split, "test_arraylist_view_split" },
+    { test_arraylist_pool, "test_arraylist_pool" },
 };
 
 const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
@@ -0,0 +1,229 @@
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <execution>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "../code/arraylist.hpp"
+
+using datastructures::arraylist;
+
+typedef struct UnitTest {
+    void (*fn)();
+    const char *name;
+} UnitTest;
+
+/* Counts copies and moves of its instances */
+struct Tracked {
+    static int copies;
+    static int moves;
+    int key;
+
+    Tracked() : key(0) {}
+    Tracked(int key) : key(key) {}
+    Tracked(const Tracked &other) : key(other.key) { copies++; }
+    Tracked(Tracked &&other) noexcept : key(other.key) { moves++; }
+    Tracked &operator=(const Tracked &other) { key = other.key; copies++; return *this; }
+    Tracked &operator=(Tracked &&other) noexcept { key = other.key; moves++; return *this; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+/* Counts live allocations, and is unequal across ids */
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::false_type;
+    static int live;
+    int id;
+
+    explicit CountingAllocator(int id) : id(id) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other) : id(other.id) {}
+
+    T *allocate(std::size_t n) {
+        live += n;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, std::size_t n) {
+        live -= n;
+        std::allocator<T>().deallocate(p, n);
+    }
+    friend bool operator==(const CountingAllocator &a, const CountingAllocator &b) { return a.id == b.id; }
+    friend bool operator!=(const CountingAllocator &a, const CountingAllocator &b) { return a.id != b.id; }
+};
+template <typename T>
+int CountingAllocator<T>::live = 0;
+
+/**
+ * Case default is empty.
+ * Case count and value.
+ * Case initializer list.
+ * Case out of range access throws.
+*/
+void test_arraylist_cpp_init() {
+    const arraylist<int> inputs[] = {
+        arraylist<int>(),
+        arraylist<int>(5, 7),
+        arraylist<int>{ 1, 2, 3 },
+    };
+
+    /* Test */
+    assert(inputs[0].empty());
+    assert(inputs[0].begin() == inputs[0].end());
+    assert(inputs[1].size() == 5);
+    assert(std::all_of(inputs[1].begin(), inputs[1].end(), [](int v) { return v == 7; }));
+    assert(inputs[2].front() == 1 && inputs[2].back() == 3 && inputs[2][1] == 2);
+    bool thrown = false;
+    try {
+        inputs[2].at(3);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+/**
+ * Case emplace_back constructs in place.
+ * Case move construction and assignment steal the Arraylist.
+ * Case copies are deep.
+*/
+void test_arraylist_cpp_move() {
+    arraylist<Tracked> input;
+    for (int i = 0; i < 100; i++) {
+        input.emplace_back(i);
+    }
+    Tracked::copies = 0;
+    Tracked::moves = 0;
+    const Arraylist handle = input.arraylist_handle();
+
+    /* Test */
+    arraylist<Tracked> moved(std::move(input));
+    assert(moved.arraylist_handle() == handle);
+    assert(input.empty());
+    arraylist<Tracked> assigned;
+    assigned = std::move(moved);
+    assert(assigned.arraylist_handle() == handle);
+    assert(assigned.size() == 100 && assigned[99].key == 99);
+    assert(Tracked::copies == 0 && Tracked::moves == 0);
+    arraylist<Tracked> copied(assigned);
+    assert(Tracked::copies == 100);
+    copied[0].key = -1;
+    assert(assigned[0].key == 0);
+    input = copied;
+    assert(input.size() == 100 && input[0].key == -1);
+}
+
+/**
+ * Case standard algorithms, sequential and parallel.
+ * Case reverse and const iteration.
+*/
+void test_arraylist_cpp_algorithms() {
+    arraylist<int> input;
+    for (int i = 0; i < 10000; i++) {
+        input.push_back((i * 7919) % 10000);
+    }
+
+    /* Test */
+    std::sort(input.begin(), input.end());
+    for (int i = 0; i < 10000; i++) {
+        assert(input[i] == i);
+    }
+    std::reverse(input.begin(), input.end());
+    assert(input.front() == 9999);
+    std::sort(std::execution::par, input.begin(), input.end());
+    assert(std::is_sorted(input.cbegin(), input.cend()));
+    assert(std::reduce(std::execution::par, input.begin(), input.end(), 0L) == 49995000L);
+    assert(*input.rbegin() == 9999);
+    assert(std::lower_bound(input.begin(), input.end(), 1234) - input.begin() == 1234);
+    const arraylist<int> &view = input;
+    assert(std::accumulate(view.begin(), view.end(), 0L) == 49995000L);
+}
+
+/**
+ * Case insert and emplace in the middle.
+ * Case erase a range.
+ * Case resize grows and shrinks.
+ * Case resize value-initializes new elements in place.
+*/
+void test_arraylist_cpp_insert_erase() {
+    arraylist<std::string> input{ "a", "d" };
+
+    /* Test */
+    auto it = input.insert(input.begin() + 1, "b");
+    assert(*it == "b");
+    input.emplace(input.begin() + 2, 1, 'c');
+    assert((std::vector<std::string>(input.begin(), input.end()) == std::vector<std::string>{ "a", "b", "c", "d" }));
+    it = input.erase(input.begin() + 1, input.begin() + 3);
+    assert(*it == "d" && input.size() == 2);
+    input.resize(5, "e");
+    assert(input.size() == 5 && input[4] == "e");
+    input.resize(1);
+    assert(input.size() == 1 && input.back() == "a");
+    input.pop_back();
+    assert(input.empty());
+
+    arraylist<Tracked> tracked;
+    Tracked::copies = 0;
+    Tracked::moves = 0;
+    tracked.resize(50);
+    assert(tracked.size() == 50 && tracked[49].key == 0);
+    assert(Tracked::copies == 0 && Tracked::moves == 0);
+    arraylist<int> ints{ 1, 2, 3 };
+    ints.resize(1);
+    ints.resize(3);
+    assert(ints[0] == 1 && ints[1] == 0 && ints[2] == 0);
+}
+
+/**
+ * Case elements are allocated and freed through the allocator.
+ * Case move assignment across unequal allocators moves elements.
+ * Case small trivially copyable elements are stored in the Values.
+*/
+void test_arraylist_cpp_allocator() {
+    using Counted = arraylist<Tracked, CountingAllocator<Tracked>>;
+    {
+        Counted a(CountingAllocator<Tracked>(1));
+        Counted b(CountingAllocator<Tracked>(2));
+        for (int i = 0; i < 10; i++) {
+            a.push_back(i);
+        }
+
+        /* Test */
+        assert(CountingAllocator<Tracked>::live == 10);
+        b = std::move(a);
+        assert(b.get_allocator().id == 2);
+        assert(b.size() == 10 && a.empty());
+        assert(CountingAllocator<Tracked>::live == 10);
+        Counted c(std::move(b));
+        assert(c.get_allocator().id == 2 && c.size() == 10 && c[9].key == 9);
+    }
+    assert(CountingAllocator<Tracked>::live == 0);
+
+    arraylist<int, CountingAllocator<int>> inline_ints(CountingAllocator<int>(1));
+    for (int i = 0; i < 10; i++) {
+        inline_ints.push_back(i);
+    }
+    assert(CountingAllocator<int>::live == 0);
+    const Arraylist handle = inline_ints.arraylist_handle();
+    assert(*reinterpret_cast<const int *>(&handle->array[7]) == 7);
+}
+
+const UnitTest TESTS[] = {
+    { test_arraylist_cpp_init, "test_arraylist_cpp_init" },
+    { test_arraylist_cpp_move, "test_arraylist_cpp_move" },
+    { test_arraylist_cpp_algorithms, "test_arraylist_cpp_algorithms" },
+    { test_arraylist_cpp_insert_erase, "test_arraylist_cpp_insert_erase" },
+    { test_arraylist_cpp_allocator, "test_arraylist_cpp_allocator" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
@@ -0,0 +1,155 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <assert.h>
+#include "../code/arraylist_parallel.h"
+
+#define LENGTH 100003
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+
+void assert_int(const intptr_t result, const intptr_t expected) {
+    assert(result == expected);
+}
+
+void assert_value(const Value result, const Value expected) {
+    assert(result == expected);
+}
+
+Value sum_op(Value a, Value b, void *context) {
+    return (Value)((intptr_t)a + (intptr_t)b);
+}
+
+/* Associative but not commutative, so partials must combine in order */
+Value right_op(Value a, Value b, void *context) {
+    return b ? b : a;
+}
+
+Arraylist numbers(const int length) {
+    const Arraylist a = arraylist_init(length);
+    for (int i = 0; i < length; i++) {
+        a->array[i] = (Value)(intptr_t)((i * 7919) % 1000 - 500);
+    }
+    return a;
+}
+
+/**
+ * Case empty returns init.
+ * Case serial and parallel sums agree.
+ * Case parallel partials combine in order.
+*/
+void test_arraylist_reduce() {
+    const Arraylist inputs[] = {
+        arraylist_init(0),
+        numbers(LENGTH),
+    };
+    intptr_t expected = 0;
+    for (int i = 0; i < LENGTH; i++) {
+        expected += (intptr_t)inputs[1]->array[i];
+    }
+
+    /* Test */
+    assert_value(arraylist_reduce(inputs[0], (Value)7, sum_op, NULL), (Value)7);
+    assert_value(arraylist_reduce_parallel(inputs[0], (Value)7, sum_op, NULL, 4), (Value)7);
+    assert_int((intptr_t)arraylist_reduce(inputs[1], (Value)7, sum_op, NULL), expected + 7);
+    for (int threads = 0; threads <= 8; threads++) {
+        assert_int((intptr_t)arraylist_reduce_parallel(inputs[1], (Value)7, sum_op, NULL, threads), expected + 7);
+    }
+    assert_value(arraylist_reduce_parallel(inputs[1], NULL, right_op, NULL, 8), inputs[1]->array[LENGTH - 1]);
+
+    /* Free */
+    for (int i = 0; i < 2; i++) {
+        arraylist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case inclusive and exclusive, serial and parallel, agree with a loop.
+ * Case scan marks the index for rebuilding.
+*/
+void test_arraylist_scan() {
+    const Arraylist original = numbers(LENGTH);
+
+    for (int inclusive = 0; inclusive < 2; inclusive++) {
+        for (int threads = 1; threads <= 8; threads *= 2) {
+            const Arraylist input = numbers(LENGTH);
+            arraylist_index_enable(input);
+
+            /* Test */
+            assert(arraylist_scan_parallel(input, (Value)3, sum_op, NULL, inclusive, threads) == input);
+            intptr_t running = 3;
+            for (int i = 0; i < LENGTH; i++) {
+                if (inclusive) {
+                    running += (intptr_t)original->array[i];
+                }
+                assert_int((intptr_t)input->array[i], running);
+                if (!inclusive) {
+                    running += (intptr_t)original->array[i];
+                }
+            }
+            assert(input->index->dirty);
+
+            /* Free */
+            arraylist_free(input);
+        }
+    }
+
+    /* Test */
+    const Arraylist input = numbers(3);
+    arraylist_scan(input, (Value)0, sum_op, NULL, false);
+    assert_int((intptr_t)input->array[0], 0);
+    assert_int((intptr_t)input->array[2], (intptr_t)original->array[0] + (intptr_t)original->array[1]);
+
+    /* Free */
+    arraylist_free(input);
+    arraylist_free(original);
+}
+
+/**
+ * Case empty.
+ * Case sum, min and max agree with a loop for several thread counts.
+*/
+void test_arraylist_intptr_builtins() {
+    const Arraylist empty = arraylist_init(0);
+    const Arraylist input = numbers(LENGTH);
+    intptr_t sum = 0, min = INTPTR_MAX, max = INTPTR_MIN;
+    for (int i = 0; i < LENGTH; i++) {
+        const intptr_t number = (intptr_t)input->array[i];
+        sum += number;
+        min = (number < min) ? number : min;
+        max = (number > max) ? number : max;
+    }
+
+    /* Test */
+    assert_int(arraylist_sum_intptr(empty, 4), 0);
+    assert_int(arraylist_min_intptr(empty, 4), INTPTR_MAX);
+    assert_int(arraylist_max_intptr(empty, 4), INTPTR_MIN);
+    for (int threads = 1; threads <= 8; threads++) {
+        assert_int(arraylist_sum_intptr(input, threads), sum);
+        assert_int(arraylist_min_intptr(input, threads), min);
+        assert_int(arraylist_max_intptr(input, threads), max);
+    }
+
+    /* Free */
+    arraylist_free(empty);
+    arraylist_free(input);
+}
+
+const UnitTest TESTS[] = {
+    { test_arraylist_reduce, "test_arraylist_reduce" },
+    { test_arraylist_scan, "test_arraylist_scan" },
+    { test_arraylist_intptr_builtins, "test_arraylist_intptr_builtins" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
@@ -0,0 +1,576 @@
+/**
+ * Implementation file for Bitlist.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include "bitlist.h"
+
+#define WORD_BITS 64
+
+static const int MIN_CAPACITY = WORD_BITS;
+static const float MIN_FILLED_RATIO = .3;
+static const float IDEAL_FILLED_RATIO = .5;
+static const float MAX_FILLED_RATIO = .7;
+
+static bool invalid_index(const Bitlist b, const int index);
+static Bitlist fix_capacity(const Bitlist b);
+static void clear_bits(const Bitlist b, const int from, const int to);
+static int num_words(const int bits);
+static Word low_mask(const int bits);
+
+/**
+ * Initialized a new Bitlist with every bit 0.
+ *
+ * Inputs:
+ *     const int initial_length: Initial length of bits.
+ * Returns:
+ *     Bitlist: NULL if the process fails,
+ *              Bitlist that is newly created otherwise.
+*/
+Bitlist bitlist_init(const int initial_length) {
+    if (initial_length < 0) {
+        return NULL;
+    }
+
+    /* Initial size */
+    float ideal_capacity = (float)initial_length / (float)IDEAL_FILLED_RATIO;
+    int initial_capacity =
+        MIN_CAPACITY > ideal_capacity
+        ? MIN_CAPACITY
+        : ideal_capacity;
+    const int words = num_words(initial_capacity);
+
+    /* Malloc */
+    Bitlist b = malloc(sizeof(*b));
+    Word *array = calloc(words, sizeof(*array));
+
+    if (b == NULL || array == NULL) {
+        free(b);
+        free(array);
+        return NULL;
+    }
+
+    /* Initialize */
+    b->length = initial_length;
+    b->capacity = words * WORD_BITS;
+    b->array = array;
+
+    return b;
+}
+
+/**
+ * Free a Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ * Returns:
+ *     Nothing.
+*/
+void bitlist_free(Bitlist b) {
+    if (b) {
+        free(b->array);
+        free(b);
+    }
+}
+
+/**
+ * Query whether the Bitlist has a length of 0.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ * Returns:
+ *     bool: Whether the Bitlist has a length of 0.
+*/
+bool bitlist_empty(const Bitlist b) {
+    return b->length == 0;
+}
+
+/**
+ * Remove all bits from the Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ * Returns:
+ *     Bitlist: NULL if the process fails,
+ *              Bitlist otherwise.
+*/
+Bitlist bitlist_clear(const Bitlist b) {
+    return bitlist_resize(b, 0);
+}
+
+/**
+ * Get an index's bit from a Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          bit at the Bitlist's index otherwise.
+*/
+int bitlist_get(const Bitlist b, const int index) {
+    if (invalid_index(b, index)) {
+        return -1;
+    }
+    return (b->array[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+/**
+ * Get an index's bit, remove that bit, and shift bits over.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          bit at the Bitlist's index otherwise.
+*/
+int bitlist_pop(const Bitlist b, const int index) {
+    if (invalid_index(b, index)) {
+        return -1;
+    }
+
+    /* Get value */
+    const int value = bitlist_get(b, index);
+
+    /* Shift bits down a word at a time, bits past length are 0 */
+    const int first = index / WORD_BITS;
+    const int last = (b->length - 1) / WORD_BITS;
+    const Word mask = low_mask(index % WORD_BITS);
+    b->array[first] =
+        (b->array[first] & mask)
+        | ((b->array[first] >> 1) & ~mask);
+    for (int i = first; i < last; i++) {
+        b->array[i] |= b->array[i + 1] << (WORD_BITS - 1);
+        b->array[i + 1] >>= 1;
+    }
+
+    /* Shrink array */
+    if (!bitlist_resize(b, b->length - 1)) {
+        return -1;
+    }
+    return value;
+}
+
+/**
+ * Set an index's bit from a Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int index: The index to access.
+ *     const bool value: The bit to set at the Bitlist's index.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          bit that was inserted otherwise.
+*/
+int bitlist_set(const Bitlist b, const int index, const bool value) {
+    if (index < 0) {
+        return -1;
+    }
+
+    /* Keep array the same or expand array to index */
+    const int new_length = (index < b->length) ? (b->length) : (index + 1);
+    if (!bitlist_resize(b, new_length)) {
+        return -1;
+    }
+
+    /* Set value */
+    const Word bit = (Word)1 << (index % WORD_BITS);
+    if (value) {
+        b->array[index / WORD_BITS] |= bit;
+    } else {
+        b->array[index / WORD_BITS] &= ~bit;
+    }
+    return value;
+}
+
+/**
+ * Set an index's bit, shifting bits further back in a Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: The Bitlist to use.
+ *     const int index: The index to access.
+ *     const bool value: The bit to set at the Bitlist's index.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          bit that was inserted otherwise.
+*/
+int bitlist_push(const Bitlist b, const int index, const bool value) {
+    if (index < 0) {
+        return -1;
+    }
+    if (index >= b->length) {
+        return bitlist_set(b, index, value);
+    }
+
+    /* Expand array to +1 */
+    const int new_length = b->length + 1;
+    if (!bitlist_resize(b, new_length)) {
+        return -1;
+    }
+
+    /* Shift bits up a word at a time */
+    const int first = index / WORD_BITS;
+    const int last = (new_length - 1) / WORD_BITS;
+    for (int i = last; i > first; i--) {
+        b->array[i] = (b->array[i] << 1) | (b->array[i - 1] >> (WORD_BITS - 1));
+    }
+    const Word mask = low_mask(index % WORD_BITS);
+    b->array[first] =
+        (b->array[first] & mask)
+        | ((b->array[first] & ~mask) << 1)
+        | ((Word)value << (index % WORD_BITS));
+    return value;
+}
+
+/**
+ * Get the length of the bits of a Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ * Returns:
+ *     int: The length of the bits in the Bitlist.
+*/
+int bitlist_length(const Bitlist b) {
+    return b->length;
+}
+
+/**
+ * Get the number of bits the internal array of a Bitlist holds.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ * Returns:
+ *     int: The capacity of the internal array of the Bitlist.
+*/
+int bitlist_capacity(const Bitlist b) {
+    return b->capacity;
+}
+
+/**
+ * Reallocates the internal array of a Bitlist to hold a number of bits,
+ * rounded up to a whole word.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int capacity: The new capacity in bits to use, at most
+ *                         INT_MAX - WORD_BITS + 1 so it rounds up within an int.
+ * Returns:
+ *     Bitlist: NULL if the process fails,
+ *              Bitlist otherwise.
+*/
+Bitlist bitlist_reserve(const Bitlist b, const int capacity) {
+    if (capacity < 0 || capacity > INT_MAX - WORD_BITS + 1) {
+        return NULL;
+    }
+
+    const int old_words = num_words(b->capacity);
+    const int words = num_words(capacity);
+    if (words > 0) {
+        Word *array = realloc(b->array, words * sizeof(*array));
+        if (!array) {
+            return NULL;
+        }
+        b->array = array;
+    }
+
+    /* Zero-out new words */
+    if (words > old_words) {
+        memset(b->array + old_words, 0, (words - old_words) * sizeof(*b->array));
+    }
+
+    /* Truncate, keeping bits past length 0 */
+    b->capacity = words * WORD_BITS;
+    if (b->length > b->capacity) {
+        b->length = b->capacity;
+    }
+    clear_bits(b, b->length, b->capacity);
+    return b;
+}
+
+/**
+ * Sets the length of the Bitlist.  New bits are 0.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int length: The new length to use.
+ * Returns:
+ *     Bitlist: NULL if the process fails,
+ *              Bitlist otherwise.
+*/
+Bitlist bitlist_resize(const Bitlist b, const int length) {
+    if (length < 0) {
+        return NULL;
+    }
+    if (length < b->length) {
+        clear_bits(b, length, b->length);
+    }
+    b->length = length;
+    return fix_capacity(b);
+}
+
+/**
+ * Count the bits set in the Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ * Returns:
+ *     int: Number of bits that are 1.
+*/
+int bitlist_popcount(const Bitlist b) {
+    const int words = num_words(b->length);
+    int count = 0;
+    for (int i = 0; i < words; i++) {
+        count += __builtin_popcountll(b->array[i]);
+    }
+    return count;
+}
+
+/**
+ * Find the first set bit at or after an index.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int from: The index to start searching at.
+ * Returns:
+ *     int: -1 if there is no set bit or from is invalid,
+ *          index of the first set bit otherwise.
+*/
+int bitlist_find_first_set(const Bitlist b, const int from) {
+    if (invalid_index(b, from)) {
+        return -1;
+    }
+
+    const int words = num_words(b->length);
+    int i = from / WORD_BITS;
+    Word word = b->array[i] & ~low_mask(from % WORD_BITS);
+    while (true) {
+        if (word) {
+            return i * WORD_BITS + __builtin_ctzll(word);
+        }
+        if (++i >= words) {
+            return -1;
+        }
+        word = b->array[i];
+    }
+}
+
+/**
+ * Count the bits set before an index.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int index: The index to count up to, exclusive.
+ * Returns:
+ *     int: -1 if index is outside of 0 to length,
+ *          number of set bits in indices 0 to index - 1 otherwise.
+*/
+int bitlist_rank(const Bitlist b, const int index) {
+    if (index < 0 || index > b->length) {
+        return -1;
+    }
+
+    const int words = index / WORD_BITS;
+    int count = 0;
+    for (int i = 0; i < words; i++) {
+        count += __builtin_popcountll(b->array[i]);
+    }
+    if (index % WORD_BITS) {
+        count += __builtin_popcountll(b->array[words] & low_mask(index % WORD_BITS));
+    }
+    return count;
+}
+
+/**
+ * Find the index of a set bit by its rank, the inverse of bitlist_rank.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int rank: Number of set bits before the one to find.
+ * Returns:
+ *     int: -1 if there are not enough set bits,
+ *          index of the set bit otherwise.
+*/
+int bitlist_select(const Bitlist b, const int rank) {
+    if (rank < 0) {
+        return -1;
+    }
+
+    const int words = num_words(b->length);
+    int remaining = rank;
+    for (int i = 0; i < words; i++) {
+        Word word = b->array[i];
+        const int count = __builtin_popcountll(word);
+        if (remaining >= count) {
+            remaining -= count;
+            continue;
+        }
+
+        /* Drop lower set bits within the word */
+        for (int j = 0; j < remaining; j++) {
+            word &= word - 1;
+        }
+        return i * WORD_BITS + __builtin_ctzll(word);
+    }
+    return -1;
+}
+
+/**
+ * Bitwise AND a Bitlist into another.  Bits of dst past the length of
+ * src are treated as ANDed with 0.
+ *
+ * Inputs:
+ *     const Bitlist dst: Bitlist to change.
+ *     const Bitlist src: Bitlist to combine with.
+ * Returns:
+ *     Bitlist: dst.
+*/
+Bitlist bitlist_and(const Bitlist dst, const Bitlist src) {
+    const int dst_words = num_words(dst->length);
+    const int src_words = num_words(src->length);
+    const int words = dst_words < src_words ? dst_words : src_words;
+    for (int i = 0; i < words; i++) {
+        dst->array[i] &= src->array[i];
+    }
+    memset(dst->array + words, 0, (dst_words - words) * sizeof(*dst->array));
+    return dst;
+}
+
+/**
+ * Bitwise OR a Bitlist into another.  Bits of src past the length of
+ * dst are ignored.
+ *
+ * Inputs:
+ *     const Bitlist dst: Bitlist to change.
+ *     const Bitlist src: Bitlist to combine with.
+ * Returns:
+ *     Bitlist: dst.
+*/
+Bitlist bitlist_or(const Bitlist dst, const Bitlist src) {
+    const int dst_words = num_words(dst->length);
+    const int src_words = num_words(src->length);
+    const int words = dst_words < src_words ? dst_words : src_words;
+    for (int i = 0; i < words; i++) {
+        dst->array[i] |= src->array[i];
+    }
+    clear_bits(dst, dst->length, dst->capacity);
+    return dst;
+}
+
+/**
+ * Bitwise XOR a Bitlist into another.  Bits of src past the length of
+ * dst are ignored.
+ *
+ * Inputs:
+ *     const Bitlist dst: Bitlist to change.
+ *     const Bitlist src: Bitlist to combine with.
+ * Returns:
+ *     Bitlist: dst.
+*/
+Bitlist bitlist_xor(const Bitlist dst, const Bitlist src) {
+    const int dst_words = num_words(dst->length);
+    const int src_words = num_words(src->length);
+    const int words = dst_words < src_words ? dst_words : src_words;
+    for (int i = 0; i < words; i++) {
+        dst->array[i] ^= src->array[i];
+    }
+    clear_bits(dst, dst->length, dst->capacity);
+    return dst;
+}
+
+/**
+ * Whether an input index is not accessible in the Bitlist.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     bool: Whether the index is outside of range.
+*/
+static bool invalid_index(const Bitlist b, const int index) {
+    return index < 0 || index > b->length - 1;
+}
+
+/**
+ * Update the size of the internal array to fit the Bitlist length.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to change the size of.
+ * Returns:
+ *     Bitlist: NULL if the process fails,
+ *              Bitlist otherwise.
+*/
+static Bitlist fix_capacity(const Bitlist b) {
+    /* In good range */
+    float curr_ratio = (float)b->length / (float)b->capacity;
+    if (curr_ratio > MIN_FILLED_RATIO && curr_ratio < MAX_FILLED_RATIO) {
+        return b;
+    }
+
+    float new_capacity = b->length / IDEAL_FILLED_RATIO;
+
+    /* Reserve min capacity */
+    if (new_capacity < MIN_CAPACITY) {
+        return b->capacity == MIN_CAPACITY ? b : bitlist_reserve(b, MIN_CAPACITY);
+    }
+
+    /* Reserve max capacity, rounded down to a whole word */
+    if (new_capacity > INT_MAX - WORD_BITS) {
+        return bitlist_reserve(b, INT_MAX - WORD_BITS + 1);
+    }
+    return bitlist_reserve(b, new_capacity);
+}
+
+/**
+ * Zero the bits from one index up to another.
+ *
+ * Inputs:
+ *     const Bitlist b: Bitlist to change.
+ *     const int from: First index to clear.
+ *     const int to: Index to stop clearing at, exclusive.
+ * Returns:
+ *     Nothing.
+*/
+static void clear_bits(const Bitlist b, const int from, const int to) {
+    if (from >= to) {
+        return;
+    }
+
+    int first = from / WORD_BITS;
+    if (from % WORD_BITS) {
+        b->array[first] &= low_mask(from % WORD_BITS);
+        first++;
+    }
+    const int last = num_words(to);
+    if (last > first) {
+        memset(b->array + first, 0, (last - first) * sizeof(*b->array));
+    }
+}
+
+/**
+ * Number of words needed to hold a number of bits.
+ *
+ * Inputs:
+ *     const int bits: Number of bits.
+ * Returns:
+ *     int: Number of words.
+*/
+static int num_words(const int bits) {
+    return (int)(((long)bits + WORD_BITS - 1) / WORD_BITS);
+}
+
+/**
+ * Word with the lowest bits set.
+ *
+ * Inputs:
+ *     const int bits: Number of low bits to set, 0 to 63.
+ * Returns:
+ *     Word: Mask of the low bits.
+*/
+static Word low_mask(const int bits) {
+    return ((Word)1 << bits) - 1;
+}
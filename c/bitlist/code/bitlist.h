@@ -0,0 +1,53 @@
+/**
+ * Header file for Bitlist.
+ *
+ * A list of booleans packed 64 to a word, with the same
+ * push/pop/get/set/resize semantics as the Arraylist.
+*/
+
+#ifndef BITLIST_H_
+#define BITLIST_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct Bitlist *Bitlist;
+typedef uint64_t Word;
+struct Bitlist {
+    int length;  /* Length of bits */
+    int capacity;  /* Length of bits the internal array holds */
+    Word *array;  /* Bits past length are always 0 */
+};
+
+/* Initialize/Free */
+Bitlist bitlist_init(const int initial_len);
+void bitlist_free(const Bitlist b);
+
+/* Get/Remove bits */
+bool bitlist_empty(const Bitlist b);
+Bitlist bitlist_clear(const Bitlist b);
+int bitlist_get(const Bitlist b, const int index);
+int bitlist_pop(const Bitlist b, const int index);
+int bitlist_set(const Bitlist b, const int index, const bool value);
+int bitlist_push(const Bitlist b, const int index, const bool value);
+
+/* Get size */
+int bitlist_length(const Bitlist b);
+int bitlist_capacity(const Bitlist b);
+
+/* Set size */
+Bitlist bitlist_resize(const Bitlist b, const int length);
+Bitlist bitlist_reserve(const Bitlist b, const int capacity);
+
+/* Query */
+int bitlist_popcount(const Bitlist b);
+int bitlist_find_first_set(const Bitlist b, const int from);
+int bitlist_rank(const Bitlist b, const int index);
+int bitlist_select(const Bitlist b, const int rank);
+
+/* Combine */
+Bitlist bitlist_and(const Bitlist dst, const Bitlist src);
+Bitlist bitlist_or(const Bitlist dst, const Bitlist src);
+Bitlist bitlist_xor(const Bitlist dst, const Bitlist src);
+
+#endif
@@ -0,0 +1,424 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "../code/bitlist.h"
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+typedef struct TestInt {
+    int result;
+    int expected;
+} TestInt;
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_bits(const Bitlist result, const char *expected) {
+    const int length = strlen(expected);
+    assert_int(result->length, length);
+    for (int i = 0; i < length; i++) {
+        assert_int(bitlist_get(result, i), expected[i] == '1');
+    }
+
+    /* Bits past length stay 0 */
+    for (int i = length; i < result->capacity; i++) {
+        assert_int((result->array[i / 64] >> (i % 64)) & 1, 0);
+    }
+}
+
+Bitlist bits(const char *input) {
+    const Bitlist b = bitlist_init(0);
+    for (int i = 0; input[i]; i++) {
+        bitlist_set(b, i, input[i] == '1');
+    }
+    return b;
+}
+
+/**
+ * Case initial length is negative.
+ * Case initial length is below minimum capacity.
+ * Case default.
+*/
+void test_bitlist_init() {
+    const Bitlist inputs[] = {
+        bitlist_init(-1),
+        bitlist_init(0),
+        bitlist_init(100),
+    };
+    const TestInt tests[] = {
+        { inputs[1]->length, 0 },
+        { inputs[1]->capacity, 64 },
+        { inputs[2]->length, 100 },
+        { inputs[2]->capacity, 256 },
+        { bitlist_popcount(inputs[2]), 0 },
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    assert(inputs[0] == NULL);
+    for (int i = 0; i < num_tests; i++) {
+        assert_int(tests[i].result, tests[i].expected);
+    }
+
+    /* Free */
+    for (int i = 0; i < 3; i++) {
+        bitlist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case is empty.
+ * Case is not empty.
+*/
+void test_bitlist_empty() {
+    const Bitlist inputs[] = {
+        bitlist_init(0),
+        bitlist_init(1),
+    };
+
+    /* Test */
+    assert(bitlist_empty(inputs[0]));
+    assert(!bitlist_empty(inputs[1]));
+    assert(bitlist_empty(bitlist_clear(inputs[1])));
+
+    /* Free */
+    bitlist_free(inputs[0]);
+    bitlist_free(inputs[1]);
+}
+
+/**
+ * Case invalid index.
+ * Case default.
+*/
+void test_bitlist_get() {
+    const Bitlist input = bits("0010");
+    const TestInt tests[] = {
+        { bitlist_get(input, -1), -1 },
+        { bitlist_get(input, 4), -1 },
+        { bitlist_get(input, 1), 0 },
+        { bitlist_get(input, 2), 1 },
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    for (int i = 0; i < num_tests; i++) {
+        assert_int(tests[i].result, tests[i].expected);
+    }
+
+    /* Free */
+    bitlist_free(input);
+}
+
+/**
+ * Case invalid index.
+ * Case default.
+ * Case bits shift across a word boundary.
+*/
+void test_bitlist_pop() {
+    const Bitlist inputs[] = {
+        bits(""),
+        bits("01101"),
+        bits("1000000000000000000000000000000000000000000000000000000000000000011"),
+    };
+    const TestInt tests[] = {
+        { bitlist_pop(inputs[0], 0), -1 },
+        { bitlist_pop(inputs[1], 2), 1 },
+        { bitlist_pop(inputs[2], 0), 1 },
+    };
+    const char *outputs[] = {
+        "",
+        "0101",
+        "000000000000000000000000000000000000000000000000000000000000000011",
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    for (int i = 0; i < num_tests; i++) {
+        assert_int(tests[i].result, tests[i].expected);
+        assert_bits(inputs[i], outputs[i]);
+    }
+
+    /* Free */
+    for (int i = 0; i < num_tests; i++) {
+        bitlist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case index below 0.
+ * Case index past length.
+ * Case index past capacity.
+ * Case default (index within length).
+*/
+void test_bitlist_set() {
+    const Bitlist inputs[] = {
+        bitlist_init(0),
+        bitlist_init(0),
+        bitlist_init(0),
+        bits("11111"),
+    };
+    const TestInt tests[] = {
+        { bitlist_set(inputs[0], -1, true), -1 },
+        { bitlist_set(inputs[1], 3, true), 1 },
+        { bitlist_set(inputs[2], 100, true), 1 },
+        { bitlist_set(inputs[3], 3, false), 0 },
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    for (int i = 0; i < num_tests; i++) {
+        assert_int(tests[i].result, tests[i].expected);
+    }
+    assert_bits(inputs[0], "");
+    assert_bits(inputs[1], "0001");
+    assert_int(inputs[2]->length, 101);
+    assert_int(inputs[2]->capacity, 256);
+    assert_int(bitlist_popcount(inputs[2]), 1);
+    assert_bits(inputs[3], "11101");
+
+    /* Free */
+    for (int i = 0; i < num_tests; i++) {
+        bitlist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case index below 0.
+ * Case index past length.
+ * Case default (index within length).
+ * Case bits shift across a word boundary.
+*/
+void test_bitlist_push() {
+    const Bitlist inputs[] = {
+        bitlist_init(0),
+        bitlist_init(0),
+        bits("0101"),
+        bits("000000000000000000000000000000000000000000000000000000000000000011"),
+    };
+    const TestInt tests[] = {
+        { bitlist_push(inputs[0], -1, true), -1 },
+        { bitlist_push(inputs[1], 3, true), 1 },
+        { bitlist_push(inputs[2], 2, true), 1 },
+        { bitlist_push(inputs[3], 0, true), 1 },
+    };
+    const char *outputs[] = {
+        "",
+        "0001",
+        "01101",
+        "1000000000000000000000000000000000000000000000000000000000000000011",
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    for (int i = 0; i < num_tests; i++) {
+        assert_int(tests[i].result, tests[i].expected);
+        assert_bits(inputs[i], outputs[i]);
+    }
+
+    /* Free */
+    for (int i = 0; i < num_tests; i++) {
+        bitlist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case default.
+*/
+void test_bitlist_length() {
+    const Bitlist input = bitlist_init(5);
+
+    /* Test */
+    assert_int(bitlist_length(input), 5);
+    assert_int(bitlist_capacity(input), 64);
+
+    /* Free */
+    bitlist_free(input);
+}
+
+/**
+ * Case capacity is negative.
+ * Case capacity would round up past INT_MAX.
+ * Case capacity rounds up to a word.
+ * Case capacity truncates bits.
+*/
+void test_bitlist_reserve() {
+    const Bitlist inputs[] = {
+        bitlist_init(0),
+        bitlist_init(0),
+        bits("1111111111"),
+    };
+
+    /* Test */
+    assert(bitlist_reserve(inputs[0], -1) == NULL);
+    assert(bitlist_reserve(inputs[0], INT_MAX - 62) == NULL);
+    assert(bitlist_reserve(inputs[0], INT_MAX) == NULL);
+    assert_int(inputs[0]->capacity, 64);
+    assert(bitlist_reserve(inputs[1], 65) == inputs[1]);
+    assert_int(inputs[1]->capacity, 128);
+    assert(bitlist_reserve(inputs[2], 0) == inputs[2]);
+    assert_int(inputs[2]->length, 0);
+    assert(bitlist_reserve(inputs[2], 64) == inputs[2]);
+    assert_int(bitlist_popcount(inputs[2]), 0);
+
+    /* Free */
+    for (int i = 0; i < 3; i++) {
+        bitlist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case length is negative.
+ * Case shrink clears dropped bits.
+ * Case grow.
+*/
+void test_bitlist_resize() {
+    const Bitlist input = bits("0111");
+
+    /* Test */
+    assert(bitlist_resize(input, -1) == NULL);
+    assert(bitlist_resize(input, 2) == input);
+    assert_bits(input, "01");
+    assert(bitlist_resize(input, 200) == input);
+    assert_int(input->capacity, 448);
+    assert_int(bitlist_popcount(input), 1);
+
+    /* Free */
+    bitlist_free(input);
+}
+
+/**
+ * Case default.
+*/
+void test_bitlist_popcount() {
+    const Bitlist input = bitlist_init(0);
+    for (int i = 0; i < 1000; i += 3) {
+        bitlist_set(input, i, true);
+    }
+
+    /* Test */
+    assert_int(bitlist_popcount(input), 334);
+
+    /* Free */
+    bitlist_free(input);
+}
+
+/**
+ * Case invalid index.
+ * Case none set.
+ * Case set in same word.
+ * Case set in later word.
+*/
+void test_bitlist_find_first_set() {
+    const Bitlist input = bitlist_init(300);
+    bitlist_set(input, 3, true);
+    bitlist_set(input, 200, true);
+    const TestInt tests[] = {
+        { bitlist_find_first_set(input, 300), -1 },
+        { bitlist_find_first_set(input, 201), -1 },
+        { bitlist_find_first_set(input, 0), 3 },
+        { bitlist_find_first_set(input, 4), 200 },
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    for (int i = 0; i < num_tests; i++) {
+        assert_int(tests[i].result, tests[i].expected);
+    }
+
+    /* Free */
+    bitlist_free(input);
+}
+
+/**
+ * Case invalid index.
+ * Case rank and select are inverses.
+ * Case select past last set bit.
+*/
+void test_bitlist_rank_select() {
+    const Bitlist input = bitlist_init(0);
+    for (int i = 0; i < 1000; i += 7) {
+        bitlist_set(input, i, true);
+    }
+
+    /* Test */
+    assert_int(bitlist_rank(input, -1), -1);
+    assert_int(bitlist_rank(input, input->length + 1), -1);
+    assert_int(bitlist_rank(input, input->length), bitlist_popcount(input));
+    for (int k = 0; k < bitlist_popcount(input); k++) {
+        assert_int(bitlist_select(input, k), 7 * k);
+        assert_int(bitlist_rank(input, 7 * k), k);
+    }
+    assert_int(bitlist_select(input, -1), -1);
+    assert_int(bitlist_select(input, bitlist_popcount(input)), -1);
+
+    /* Free */
+    bitlist_free(input);
+}
+
+/**
+ * Case and.
+ * Case or.
+ * Case xor.
+ * Case src shorter than dst.
+*/
+void test_bitlist_combine() {
+    const Bitlist inputs[] = {
+        bits("0011"),
+        bits("0011"),
+        bits("0011"),
+        bits("1111"),
+    };
+    const Bitlist other = bits("0101");
+    const Bitlist shorter = bits("11");
+
+    /* Test */
+    assert_bits(bitlist_and(inputs[0], other), "0001");
+    assert_bits(bitlist_or(inputs[1], other), "0111");
+    assert_bits(bitlist_xor(inputs[2], other), "0110");
+    assert_bits(bitlist_and(inputs[3], shorter), "1100");
+    assert_bits(bitlist_or(shorter, other), "11");
+
+    /* Free */
+    for (int i = 0; i < 4; i++) {
+        bitlist_free(inputs[i]);
+    }
+    bitlist_free(other);
+    bitlist_free(shorter);
+}
+
+const UnitTest TESTS[] = {
+    { test_bitlist_init, "test_bitlist_init" },
+    { test_bitlist_empty, "test_bitlist_empty" },
+    { test_bitlist_get, "test_bitlist_get" },
+    { test_bitlist_pop, "test_bitlist_pop" },
+    { test_bitlist_set, "test_bitlist_set" },
+    { test_bitlist_push, "test_bitlist_push" },
+    { test_bitlist_length, "test_bitlist_length" },
+    { test_bitlist_reserve, "test_bitlist_reserve" },
+    { test_bitlist_resize, "test_bitlist_resize" },
+    { test_bitlist_popcount, "test_bitlist_popcount" },
+    { test_bitlist_find_first_set, "test_bitlist_find_first_set" },
+    { test_bitlist_rank_select, "test_bitlist_rank_select" },
+    { test_bitlist_combine, "test_bitlist_combine" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
@@ -0,0 +1,393 @@
+/**
+ * Implementation file for Columnlist.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include "columnlist.h"
+
+static const int MIN_CAPACITY = 10;
+static const float MIN_FILLED_RATIO = .3;
+static const float IDEAL_FILLED_RATIO = .5;
+static const float MAX_FILLED_RATIO = .7;
+
+static bool invalid_index(const Columnlist c, const int index);
+static Columnlist fix_capacity(const Columnlist c);
+
+/**
+ * Initialized a new Columnlist with every field zeroed.
+ *
+ * Inputs:
+ *     const int num_columns: Number of columns in each row.
+ *     const size_t *sizes: Element size of each column.
+ *     const int initial_length: Initial length of rows.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist that is newly created otherwise.
+*/
+Columnlist columnlist_init(const int num_columns, const size_t *sizes, const int initial_length) {
+    if (num_columns < 1 || initial_length < 0) {
+        return NULL;
+    }
+    for (int i = 0; i < num_columns; i++) {
+        if (sizes[i] == 0) {
+            return NULL;
+        }
+    }
+
+    /* Initial size */
+    float ideal_capacity = (float)initial_length / (float)IDEAL_FILLED_RATIO;
+    int initial_capacity =
+        MIN_CAPACITY > ideal_capacity
+        ? MIN_CAPACITY
+        : ideal_capacity;
+
+    /* Malloc */
+    Columnlist c = malloc(sizeof(*c));
+    size_t *column_sizes = malloc(num_columns * sizeof(*column_sizes));
+    char **columns = calloc(num_columns, sizeof(*columns));
+
+    bool failed = c == NULL || column_sizes == NULL || columns == NULL;
+    for (int i = 0; !failed && i < num_columns; i++) {
+        columns[i] = calloc(initial_capacity, sizes[i]);
+        failed = columns[i] == NULL;
+    }
+    if (failed) {
+        for (int i = 0; columns && i < num_columns; i++) {
+            free(columns[i]);
+        }
+        free(c);
+        free(column_sizes);
+        free(columns);
+        return NULL;
+    }
+
+    /* Initialize */
+    memcpy(column_sizes, sizes, num_columns * sizeof(*column_sizes));
+    c->length = initial_length;
+    c->capacity = initial_capacity;
+    c->num_columns = num_columns;
+    c->sizes = column_sizes;
+    c->columns = columns;
+
+    return c;
+}
+
+/**
+ * Free a Columnlist.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ * Returns:
+ *     Nothing.
+*/
+void columnlist_free(const Columnlist c) {
+    if (c) {
+        for (int i = 0; i < c->num_columns; i++) {
+            free(c->columns[i]);
+        }
+        free(c->columns);
+        free(c->sizes);
+        free(c);
+    }
+}
+
+/**
+ * Query whether the Columnlist has a length of 0.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ * Returns:
+ *     bool: Whether the Columnlist has a length of 0.
+*/
+bool columnlist_empty(const Columnlist c) {
+    return c->length == 0;
+}
+
+/**
+ * Remove all rows from the Columnlist.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist otherwise.
+*/
+Columnlist columnlist_clear(const Columnlist c) {
+    return columnlist_resize(c, 0);
+}
+
+/**
+ * Get a pointer to one field of a row.  The pointer is invalidated by
+ * any call that changes the capacity.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int index: The row to access.
+ *     const int column: The column to access.
+ * Returns:
+ *     void *: NULL if the process fails,
+ *             pointer to the field otherwise.
+*/
+void *columnlist_get(const Columnlist c, const int index, const int column) {
+    if (invalid_index(c, index) || column < 0 || column >= c->num_columns) {
+        return NULL;
+    }
+    return c->columns[column] + (size_t)index * c->sizes[column];
+}
+
+/**
+ * Copy a row out, remove it, and shift rows over in every column.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int index: The row to access.
+ *     void *const *row: Where to copy each field, NULL entries or a NULL
+ *                       row skip the copy.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist otherwise.
+*/
+Columnlist columnlist_pop(const Columnlist c, const int index, void *const *row) {
+    if (invalid_index(c, index)) {
+        return NULL;
+    }
+
+    /* Get and shift each column */
+    const int new_length = c->length - 1;
+    for (int i = 0; i < c->num_columns; i++) {
+        const size_t size = c->sizes[i];
+        char *field = c->columns[i] + (size_t)index * size;
+        if (row && row[i]) {
+            memcpy(row[i], field, size);
+        }
+        memmove(field, field + size, (size_t)(new_length - index) * size);
+        memset(c->columns[i] + (size_t)new_length * size, 0, size);
+    }
+
+    /* Shrink arrays */
+    return columnlist_resize(c, new_length);
+}
+
+/**
+ * Set a row of a Columnlist, expanding it when past the length.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int index: The row to access.
+ *     const void *const *row: Pointer to each new field, NULL entries
+ *                             leave that field unchanged.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist otherwise.
+*/
+Columnlist columnlist_set(const Columnlist c, const int index, const void *const *row) {
+    if (index < 0) {
+        return NULL;
+    }
+
+    /* Keep arrays the same or expand arrays to index */
+    const int new_length = (index < c->length) ? (c->length) : (index + 1);
+    if (!columnlist_resize(c, new_length)) {
+        return NULL;
+    }
+
+    /* Set fields */
+    for (int i = 0; i < c->num_columns; i++) {
+        if (row && row[i]) {
+            const size_t size = c->sizes[i];
+            memcpy(c->columns[i] + (size_t)index * size, row[i], size);
+        }
+    }
+    return c;
+}
+
+/**
+ * Set a row, shifting rows further back in every column.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int index: The row to access.
+ *     const void *const *row: Pointer to each new field, NULL entries
+ *                             or a NULL row zero that field.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist otherwise.
+*/
+Columnlist columnlist_push(const Columnlist c, const int index, const void *const *row) {
+    if (index < 0) {
+        return NULL;
+    }
+
+    /* Expand arrays to +1 or expand arrays to index +1 */
+    const int old_length = c->length;
+    const int new_length = (index < old_length) ? (old_length + 1) : (index + 1);
+    if (!columnlist_resize(c, new_length)) {
+        return NULL;
+    }
+
+    /* Shift and set each column */
+    for (int i = 0; i < c->num_columns; i++) {
+        const size_t size = c->sizes[i];
+        char *field = c->columns[i] + (size_t)index * size;
+        if (index < old_length) {
+            memmove(field + size, field, (size_t)(old_length - index) * size);
+        }
+        if (row && row[i]) {
+            memcpy(field, row[i], size);
+        } else {
+            memset(field, 0, size);
+        }
+    }
+    return c;
+}
+
+/**
+ * Get the internal array of a column for direct scans.  The pointer is
+ * invalidated by any call that changes the capacity.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int column: The column to access.
+ * Returns:
+ *     void *: NULL if the column is out of range,
+ *             first element of the column otherwise.
+*/
+void *columnlist_column(const Columnlist c, const int column) {
+    if (column < 0 || column >= c->num_columns) {
+        return NULL;
+    }
+    return c->columns[column];
+}
+
+/**
+ * Get the length of the rows of a Columnlist.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ * Returns:
+ *     int: The length of the rows in the Columnlist.
+*/
+int columnlist_length(const Columnlist c) {
+    return c->length;
+}
+
+/**
+ * Get the capacity of the internal arrays of a Columnlist.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ * Returns:
+ *     int: The capacity, in rows, of the internal arrays of the Columnlist.
+*/
+int columnlist_capacity(const Columnlist c) {
+    return c->capacity;
+}
+
+/**
+ * Reallocates every internal array of a Columnlist to a new size.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int capacity: The new capacity to use.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist otherwise.
+*/
+Columnlist columnlist_reserve(const Columnlist c, const int capacity) {
+    if (capacity < 0) {
+        return NULL;
+    }
+
+    /* Columns already reallocated keep the new size if a later one fails */
+    for (int i = 0; i < c->num_columns; i++) {
+        const size_t size = c->sizes[i];
+        char *column = realloc(c->columns[i], (size_t)capacity * size);
+        if (!column && capacity > 0) {
+            if (capacity < c->capacity) {
+                c->capacity = capacity;
+            }
+            c->length = (c->length < c->capacity) ? c->length : c->capacity;
+            return NULL;
+        }
+        c->columns[i] = column;
+
+        /* Zero-out remaining elements */
+        if (capacity > c->capacity) {
+            memset(column + (size_t)c->capacity * size, 0, (size_t)(capacity - c->capacity) * size);
+        }
+    }
+
+    c->length = (c->length < capacity) ? c->length : capacity;
+    c->capacity = capacity;
+    return c;
+}
+
+/**
+ * Sets the length of the Columnlist.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int length: The new length to use.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist otherwise.
+*/
+Columnlist columnlist_resize(const Columnlist c, const int length) {
+    if (length < 0) {
+        return NULL;
+    }
+
+    /* Dropped rows read as zero if the Columnlist grows again */
+    for (int i = 0; length < c->length && i < c->num_columns; i++) {
+        const size_t size = c->sizes[i];
+        memset(c->columns[i] + (size_t)length * size, 0, (size_t)(c->length - length) * size);
+    }
+    c->length = length;
+    return fix_capacity(c);
+}
+
+/**
+ * Whether an input index is not accessible in the Columnlist.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     bool: Whether the index is outside of range.
+*/
+static bool invalid_index(const Columnlist c, const int index) {
+    return index < 0 || index > c->length - 1;
+}
+
+/**
+ * Update the size of every internal array together.
+ *
+ * Inputs:
+ *     const Columnlist c: Columnlist to change the size of.
+ * Returns:
+ *     Columnlist: NULL if the process fails,
+ *                 Columnlist otherwise.
+*/
+static Columnlist fix_capacity(const Columnlist c) {
+    /* In good range */
+    float curr_ratio = (float)c->length / (float)c->capacity;
+    if (curr_ratio > MIN_FILLED_RATIO && curr_ratio < MAX_FILLED_RATIO) {
+        return c;
+    }
+
+    float new_capacity = c->length / IDEAL_FILLED_RATIO;
+
+    /* Reserve min capacity */
+    if (new_capacity < MIN_CAPACITY) {
+        return c->capacity == MIN_CAPACITY ? c : columnlist_reserve(c, MIN_CAPACITY);
+    }
+
+    /* Reserve max capacity */
+    if (new_capacity > INT_MAX) {
+        return columnlist_reserve(c, INT_MAX);
+    }
+    return columnlist_reserve(c, new_capacity);
+}
@@ -0,0 +1,48 @@
+/**
+ * Header file for Columnlist.
+ *
+ * A list of rows stored column by column.  Every column holds elements
+ * of one fixed size in its own contiguous array, and all columns share
+ * one length and capacity, so a scan over a single field only touches
+ * that field's memory.
+*/
+
+#ifndef COLUMNLIST_H_
+#define COLUMNLIST_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct Columnlist *Columnlist;
+struct Columnlist {
+    int length;  /* Length of rows */
+    int capacity;  /* Length of rows each internal array holds */
+    int num_columns;  /* Length of columns */
+    size_t *sizes;  /* Element size of each column */
+    char **columns;  /* Internal array of each column */
+};
+
+/* Initialize/Free */
+Columnlist columnlist_init(const int num_columns, const size_t *sizes, const int initial_len);
+void columnlist_free(const Columnlist c);
+
+/* Get/Remove rows */
+bool columnlist_empty(const Columnlist c);
+Columnlist columnlist_clear(const Columnlist c);
+void *columnlist_get(const Columnlist c, const int index, const int column);
+Columnlist columnlist_pop(const Columnlist c, const int index, void *const *row);
+Columnlist columnlist_set(const Columnlist c, const int index, const void *const *row);
+Columnlist columnlist_push(const Columnlist c, const int index, const void *const *row);
+
+/* Get columns */
+void *columnlist_column(const Columnlist c, const int column);
+
+/* Get size */
+int columnlist_length(const Columnlist c);
+int columnlist_capacity(const Columnlist c);
+
+/* Set size */
+Columnlist columnlist_resize(const Columnlist c, const int length);
+Columnlist columnlist_reserve(const Columnlist c, const int capacity);
+
+#endif
@@ -0,0 +1,284 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "../code/columnlist.h"
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+typedef struct TestInt {
+    int result;
+    int expected;
+} TestInt;
+
+/* Columns of an (id, timestamp, score) record */
+enum { ID, TIMESTAMP, SCORE, NUM_COLUMNS };
+const size_t SIZES[] = { sizeof(int32_t), sizeof(int64_t), sizeof(double) };
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_row(const Columnlist c, const int index, const int32_t id, const int64_t timestamp, const double score) {
+    assert(*(int32_t *)columnlist_get(c, index, ID) == id);
+    assert(*(int64_t *)columnlist_get(c, index, TIMESTAMP) == timestamp);
+    assert(*(double *)columnlist_get(c, index, SCORE) == score);
+}
+
+Columnlist records(const int length) {
+    const Columnlist c = columnlist_init(NUM_COLUMNS, SIZES, 0);
+    for (int i = 0; i < length; i++) {
+        const int32_t id = i;
+        const int64_t timestamp = 1000 + i;
+        const double score = i / 2.0;
+        columnlist_push(c, i, (const void *[]){ &id, &timestamp, &score });
+    }
+    return c;
+}
+
+/**
+ * Case no columns.
+ * Case zero-sized column.
+ * Case initial length is negative.
+ * Case initial length is below minimum capacity.
+ * Case default.
+*/
+void test_columnlist_init() {
+    const Columnlist inputs[] = {
+        columnlist_init(0, SIZES, 0),
+        columnlist_init(2, (size_t[]){ 4, 0 }, 0),
+        columnlist_init(NUM_COLUMNS, SIZES, -1),
+        columnlist_init(NUM_COLUMNS, SIZES, 0),
+        columnlist_init(NUM_COLUMNS, SIZES, 100),
+    };
+    const TestInt tests[] = {
+        { inputs[3]->length, 0 },
+        { inputs[3]->capacity, 10 },
+        { inputs[4]->length, 100 },
+        { inputs[4]->capacity, 200 },
+        { inputs[4]->num_columns, NUM_COLUMNS },
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    assert(inputs[0] == NULL);
+    assert(inputs[1] == NULL);
+    assert(inputs[2] == NULL);
+    for (int i = 0; i < num_tests; i++) {
+        assert_int(tests[i].result, tests[i].expected);
+    }
+    assert_row(inputs[4], 99, 0, 0, 0.0);
+
+    /* Free */
+    for (int i = 0; i < 5; i++) {
+        columnlist_free(inputs[i]);
+    }
+}
+
+/**
+ * Case is empty.
+ * Case is not empty.
+*/
+void test_columnlist_empty() {
+    const Columnlist inputs[] = {
+        columnlist_init(NUM_COLUMNS, SIZES, 0),
+        columnlist_init(NUM_COLUMNS, SIZES, 1),
+    };
+
+    /* Test */
+    assert(columnlist_empty(inputs[0]));
+    assert(!columnlist_empty(inputs[1]));
+    assert(columnlist_empty(columnlist_clear(inputs[1])));
+
+    /* Free */
+    columnlist_free(inputs[0]);
+    columnlist_free(inputs[1]);
+}
+
+/**
+ * Case invalid index.
+ * Case invalid column.
+ * Case default.
+*/
+void test_columnlist_get() {
+    const Columnlist input = records(3);
+
+    /* Test */
+    assert(columnlist_get(input, 3, ID) == NULL);
+    assert(columnlist_get(input, 0, NUM_COLUMNS) == NULL);
+    assert_row(input, 2, 2, 1002, 1.0);
+
+    /* Free */
+    columnlist_free(input);
+}
+
+/**
+ * Case invalid index.
+ * Case default copies fields out and shifts every column.
+ * Case NULL row.
+*/
+void test_columnlist_pop() {
+    const Columnlist input = records(5);
+    int32_t id = 0;
+    int64_t timestamp = 0;
+
+    /* Test */
+    assert(columnlist_pop(input, 5, NULL) == NULL);
+    assert(columnlist_pop(input, 1, (void *[]){ &id, &timestamp, NULL }) == input);
+    assert_int(id, 1);
+    assert(timestamp == 1001);
+    assert_int(columnlist_length(input), 4);
+    assert_row(input, 1, 2, 1002, 1.0);
+    assert_row(input, 3, 4, 1004, 2.0);
+    assert(columnlist_pop(input, 0, NULL) == input);
+    assert_row(input, 0, 2, 1002, 1.0);
+
+    /* Free */
+    columnlist_free(input);
+}
+
+/**
+ * Case index below 0.
+ * Case index past capacity.
+ * Case default with NULL field left unchanged.
+*/
+void test_columnlist_set() {
+    const Columnlist input = records(3);
+    const int32_t id = 9;
+    const double score = 4.5;
+
+    /* Test */
+    assert(columnlist_set(input, -1, (const void *[]){ &id, NULL, &score }) == NULL);
+    assert(columnlist_set(input, 20, (const void *[]){ &id, NULL, &score }) == input);
+    assert_int(columnlist_length(input), 21);
+    assert_int(columnlist_capacity(input), 42);
+    assert_row(input, 20, 9, 0, 4.5);
+    assert_row(input, 10, 0, 0, 0.0);
+    assert(columnlist_set(input, 1, (const void *[]){ &id, NULL, &score }) == input);
+    assert_row(input, 1, 9, 1001, 4.5);
+
+    /* Free */
+    columnlist_free(input);
+}
+
+/**
+ * Case index below 0.
+ * Case index past length.
+ * Case default shifts every column.
+*/
+void test_columnlist_push() {
+    const Columnlist input = records(3);
+    const int32_t id = 9;
+    const int64_t timestamp = 7;
+    const double score = 4.5;
+
+    /* Test */
+    assert(columnlist_push(input, -1, NULL) == NULL);
+    assert(columnlist_push(input, 1, (const void *[]){ &id, &timestamp, &score }) == input);
+    assert_int(columnlist_length(input), 4);
+    assert_row(input, 0, 0, 1000, 0.0);
+    assert_row(input, 1, 9, 7, 4.5);
+    assert_row(input, 2, 1, 1001, 0.5);
+    assert_row(input, 3, 2, 1002, 1.0);
+    assert(columnlist_push(input, 6, NULL) == input);
+    assert_int(columnlist_length(input), 7);
+    assert_row(input, 6, 0, 0, 0.0);
+
+    /* Free */
+    columnlist_free(input);
+}
+
+/**
+ * Case invalid column.
+ * Case columns scan contiguously.
+*/
+void test_columnlist_column() {
+    const Columnlist input = records(100);
+
+    /* Test */
+    assert(columnlist_column(input, -1) == NULL);
+    const int64_t *timestamps = columnlist_column(input, TIMESTAMP);
+    int64_t sum = 0;
+    for (int i = 0; i < columnlist_length(input); i++) {
+        sum += timestamps[i];
+    }
+    assert(sum == 100 * 1000 + 99 * 100 / 2);
+
+    /* Free */
+    columnlist_free(input);
+}
+
+/**
+ * Case capacity is negative.
+ * Case grow keeps every column in sync.
+ * Case shrink truncates length.
+*/
+void test_columnlist_reserve() {
+    const Columnlist input = records(5);
+
+    /* Test */
+    assert(columnlist_reserve(input, -1) == NULL);
+    assert(columnlist_reserve(input, 50) == input);
+    assert_int(columnlist_capacity(input), 50);
+    assert_row(input, 4, 4, 1004, 2.0);
+    assert(columnlist_reserve(input, 2) == input);
+    assert_int(columnlist_length(input), 2);
+    assert_row(input, 1, 1, 1001, 0.5);
+
+    /* Free */
+    columnlist_free(input);
+}
+
+/**
+ * Case length is negative.
+ * Case capacity changes.
+ * Case dropped rows read as zero when grown again.
+*/
+void test_columnlist_resize() {
+    const Columnlist input = columnlist_init(NUM_COLUMNS, SIZES, 0);
+    const Columnlist rows = records(8);
+
+    /* Test */
+    assert(columnlist_resize(input, -1) == NULL);
+    assert(columnlist_resize(input, 30) == input);
+    assert_int(columnlist_length(input), 30);
+    assert_int(columnlist_capacity(input), 60);
+    assert(columnlist_resize(input, 0) == input);
+    assert_int(columnlist_capacity(input), 10);
+    assert(columnlist_resize(rows, 3) == rows);
+    assert(columnlist_resize(rows, 8) == rows);
+    assert_row(rows, 2, 2, 1002, 1.0);
+    for (int i = 3; i < 8; i++) {
+        assert_row(rows, i, 0, 0, 0.0);
+    }
+
+    /* Free */
+    columnlist_free(input);
+    columnlist_free(rows);
+}
+
+const UnitTest TESTS[] = {
+    { test_columnlist_init, "test_columnlist_init" },
+    { test_columnlist_empty, "test_columnlist_empty" },
+    { test_columnlist_get, "test_columnlist_get" },
+    { test_columnlist_pop, "test_columnlist_pop" },
+    { test_columnlist_set, "test_columnlist_set" },
+    { test_columnlist_push, "test_columnlist_push" },
+    { test_columnlist_column, "test_columnlist_column" },
+    { test_columnlist_reserve, "test_columnlist_reserve" },
+    { test_columnlist_resize, "test_columnlist_resize" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
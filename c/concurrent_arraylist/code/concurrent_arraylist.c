@@ -0,0 +1,416 @@
+/**
+ * Implementation file for ConcurrentArraylist.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include "concurrent_arraylist.h"
+
+static Arraylist copy_snapshot(const Arraylist a);
+static void publish_snapshot(const ConcurrentArraylist c, const Arraylist snapshot);
+static void reclaim_snapshots(const ConcurrentArraylist c);
+
+/**
+ * Initialized a new ConcurrentArraylist.
+ *
+ * Inputs:
+ *     const int initial_length: Initial length of the published snapshot.
+ * Returns:
+ *     ConcurrentArraylist: NULL if the process fails,
+ *                          ConcurrentArraylist that is newly created otherwise.
+*/
+ConcurrentArraylist concurrent_arraylist_init(const int initial_length) {
+    Arraylist snapshot = arraylist_init(initial_length);
+    if (snapshot == NULL) {
+        return NULL;
+    }
+
+    /* Malloc aligned so reader slots sit on their own cache lines */
+    const size_t alignment = CONCURRENT_ARRAYLIST_CACHE_LINE;
+    const size_t size =
+        (sizeof(struct ConcurrentArraylist) + alignment - 1) / alignment * alignment;
+    ConcurrentArraylist c = aligned_alloc(alignment, size);
+    if (c == NULL) {
+        arraylist_free(snapshot);
+        return NULL;
+    }
+    memset(c, 0, size);
+
+    if (pthread_mutex_init(&c->writer, NULL) != 0) {
+        arraylist_free(snapshot);
+        free(c);
+        return NULL;
+    }
+
+    /* Initialize, epoch 0 is reserved for readers outside a read section */
+    c->current = snapshot;
+    c->epoch = 1;
+    c->retired = NULL;
+
+    return c;
+}
+
+/**
+ * Free a ConcurrentArraylist.  No reader may be inside a read section.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ * Returns:
+ *     Nothing.
+*/
+void concurrent_arraylist_free(const ConcurrentArraylist c) {
+    if (c) {
+        struct ConcurrentRetired *retired = c->retired;
+        while (retired) {
+            struct ConcurrentRetired *next = retired->next;
+            arraylist_free(retired->snapshot);
+            free(retired);
+            retired = next;
+        }
+        arraylist_free(c->current);
+        pthread_mutex_destroy(&c->writer);
+        free(c);
+    }
+}
+
+/**
+ * Claim a reader slot for the calling thread.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ * Returns:
+ *     int: -1 if every reader slot is taken,
+ *          the reader slot to pass to read_begin/read_end otherwise.
+*/
+int concurrent_arraylist_register(const ConcurrentArraylist c) {
+    int reader = -1;
+
+    pthread_mutex_lock(&c->writer);
+    for (int i = 0; i < CONCURRENT_ARRAYLIST_MAX_READERS; i++) {
+        if (!c->readers[i].registered) {
+            c->readers[i].registered = true;
+            __atomic_store_n(&c->readers[i].epoch, 0, __ATOMIC_RELEASE);
+            reader = i;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&c->writer);
+
+    return reader;
+}
+
+/**
+ * Release a reader slot.  The reader must be outside a read section.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int reader: Reader slot returned by register.
+ * Returns:
+ *     Nothing.
+*/
+void concurrent_arraylist_unregister(const ConcurrentArraylist c, const int reader) {
+    if (reader < 0 || reader >= CONCURRENT_ARRAYLIST_MAX_READERS) {
+        return;
+    }
+
+    pthread_mutex_lock(&c->writer);
+    __atomic_store_n(&c->readers[reader].epoch, 0, __ATOMIC_RELEASE);
+    c->readers[reader].registered = false;
+    pthread_mutex_unlock(&c->writer);
+}
+
+/**
+ * Enter a read section.  Snapshots observed inside the section stay
+ * allocated until the matching read_end, so batch many gets per section.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int reader: Reader slot returned by register.
+ * Returns:
+ *     Nothing.
+*/
+void concurrent_arraylist_read_begin(const ConcurrentArraylist c, const int reader) {
+    const unsigned long epoch = __atomic_load_n(&c->epoch, __ATOMIC_RELAXED);
+    __atomic_store_n(&c->readers[reader].epoch, epoch, __ATOMIC_RELAXED);
+
+    /* Order the announcement before any snapshot load */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * Leave a read section.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int reader: Reader slot returned by register.
+ * Returns:
+ *     Nothing.
+*/
+void concurrent_arraylist_read_end(const ConcurrentArraylist c, const int reader) {
+    __atomic_store_n(&c->readers[reader].epoch, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * Get an index's Value from the published snapshot.
+ * Must be called inside a read section, or by a writer.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value at the snapshot's index otherwise.
+*/
+Value concurrent_arraylist_get(const ConcurrentArraylist c, const int index) {
+    const Arraylist snapshot = __atomic_load_n(&c->current, __ATOMIC_ACQUIRE);
+    if (index < 0 || index >= snapshot->length) {
+        return NULL;
+    }
+    return __atomic_load_n(&snapshot->array[index], __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Get the length of the published snapshot.
+ * Must be called inside a read section, or by a writer.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ * Returns:
+ *     int: The length of the published snapshot.
+*/
+int concurrent_arraylist_length(const ConcurrentArraylist c) {
+    const Arraylist snapshot = __atomic_load_n(&c->current, __ATOMIC_ACQUIRE);
+    return snapshot->length;
+}
+
+/**
+ * Set an index's Value.  Indices within the length are written in place;
+ * indices past the length publish an expanded copy.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int index: The index to access.
+ *     const Value value: The Value to set at the index.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+Value concurrent_arraylist_set(const ConcurrentArraylist c, const int index, const Value value) {
+    if (index < 0) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&c->writer);
+
+    /* In place */
+    if (index < c->current->length) {
+        __atomic_store_n(&c->current->array[index], value, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&c->writer);
+        return value;
+    }
+
+    /* Copy and publish */
+    Arraylist snapshot = copy_snapshot(c->current);
+    if (!snapshot || !arraylist_set(snapshot, index, value)) {
+        arraylist_free(snapshot);
+        pthread_mutex_unlock(&c->writer);
+        return NULL;
+    }
+    publish_snapshot(c, snapshot);
+
+    pthread_mutex_unlock(&c->writer);
+    return value;
+}
+
+/**
+ * Set an index's Value, shifting elements further back, and publish it.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int index: The index to access.
+ *     const Value value: The Value to set at the index.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+Value concurrent_arraylist_push(const ConcurrentArraylist c, const int index, const Value value) {
+    if (index < 0) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&c->writer);
+
+    Arraylist snapshot = copy_snapshot(c->current);
+    if (!snapshot || !arraylist_push(snapshot, index, value)) {
+        arraylist_free(snapshot);
+        pthread_mutex_unlock(&c->writer);
+        return NULL;
+    }
+    publish_snapshot(c, snapshot);
+
+    pthread_mutex_unlock(&c->writer);
+    return value;
+}
+
+/**
+ * Get an index's Value, remove that item, and publish the result.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value at the index otherwise.
+*/
+Value concurrent_arraylist_pop(const ConcurrentArraylist c, const int index) {
+    pthread_mutex_lock(&c->writer);
+
+    if (index < 0 || index >= c->current->length) {
+        pthread_mutex_unlock(&c->writer);
+        return NULL;
+    }
+
+    Arraylist snapshot = copy_snapshot(c->current);
+    if (!snapshot) {
+        pthread_mutex_unlock(&c->writer);
+        return NULL;
+    }
+    Value value = arraylist_pop(snapshot, index);
+    publish_snapshot(c, snapshot);
+
+    pthread_mutex_unlock(&c->writer);
+    return value;
+}
+
+/**
+ * Sets the length of the ConcurrentArraylist and publishes it.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const int length: The new length to use.
+ * Returns:
+ *     ConcurrentArraylist: NULL if the process fails,
+ *                          ConcurrentArraylist otherwise.
+*/
+ConcurrentArraylist concurrent_arraylist_resize(const ConcurrentArraylist c, const int length) {
+    if (length < 0) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&c->writer);
+
+    Arraylist snapshot = copy_snapshot(c->current);
+    if (!snapshot || !arraylist_resize(snapshot, length)) {
+        arraylist_free(snapshot);
+        pthread_mutex_unlock(&c->writer);
+        return NULL;
+    }
+    publish_snapshot(c, snapshot);
+
+    pthread_mutex_unlock(&c->writer);
+    return c;
+}
+
+/**
+ * Copy the elements of a snapshot into a new Arraylist of the same capacity.
+ *
+ * Inputs:
+ *     const Arraylist a: Snapshot to copy.
+ * Returns:
+ *     Arraylist: NULL if the process fails,
+ *                Arraylist that is newly created otherwise.
+*/
+static Arraylist copy_snapshot(const Arraylist a) {
+    Arraylist copy = arraylist_init(0);
+    if (!copy || !arraylist_reserve(copy, a->capacity)) {
+        arraylist_free(copy);
+        return NULL;
+    }
+
+    memcpy(copy->array, a->array, a->length * sizeof(*a->array));
+    copy->length = a->length;
+    return copy;
+}
+
+/**
+ * Replace the published snapshot and retire the old one.
+ * Must be called with the writer mutex held.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ *     const Arraylist snapshot: Snapshot to publish.
+ * Returns:
+ *     Nothing.
+*/
+static void publish_snapshot(const ConcurrentArraylist c, const Arraylist snapshot) {
+    struct ConcurrentRetired *retired = malloc(sizeof(*retired));
+    const Arraylist old = c->current;
+
+    __atomic_store_n(&c->current, snapshot, __ATOMIC_RELEASE);
+
+    /* Readers announcing a later epoch can only see the new snapshot */
+    const unsigned long epoch = __atomic_load_n(&c->epoch, __ATOMIC_RELAXED);
+    __atomic_store_n(&c->epoch, epoch + 1, __ATOMIC_SEQ_CST);
+
+    if (retired) {
+        retired->snapshot = old;
+        retired->epoch = epoch;
+        retired->next = c->retired;
+        c->retired = retired;
+    } else {
+        /* Out of memory, wait for current readers rather than leak */
+        bool waiting = true;
+        while (waiting) {
+            waiting = false;
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            for (int i = 0; i < CONCURRENT_ARRAYLIST_MAX_READERS; i++) {
+                const unsigned long reader =
+                    __atomic_load_n(&c->readers[i].epoch, __ATOMIC_ACQUIRE);
+                if (reader != 0 && reader <= epoch) {
+                    waiting = true;
+                }
+            }
+        }
+        arraylist_free(old);
+    }
+
+    reclaim_snapshots(c);
+}
+
+/**
+ * Free retired snapshots that no reader inside a read section can see.
+ * Must be called with the writer mutex held.
+ *
+ * Inputs:
+ *     const ConcurrentArraylist c: ConcurrentArraylist to use.
+ * Returns:
+ *     Nothing.
+*/
+static void reclaim_snapshots(const ConcurrentArraylist c) {
+    /* Oldest epoch any reader is still inside */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    unsigned long oldest = ULONG_MAX;
+    for (int i = 0; i < CONCURRENT_ARRAYLIST_MAX_READERS; i++) {
+        const unsigned long epoch =
+            __atomic_load_n(&c->readers[i].epoch, __ATOMIC_ACQUIRE);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    /* Snapshots retired before that epoch are unreachable */
+    struct ConcurrentRetired **link = &c->retired;
+    while (*link) {
+        struct ConcurrentRetired *retired = *link;
+        if (retired->epoch < oldest) {
+            *link = retired->next;
+            arraylist_free(retired->snapshot);
+            free(retired);
+        } else {
+            link = &retired->next;
+        }
+    }
+}
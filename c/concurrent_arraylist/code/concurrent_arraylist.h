@@ -0,0 +1,58 @@
+/**
+ * Header file for ConcurrentArraylist.
+ *
+ * A read-mostly Arraylist shared between many reader threads and
+ * writers.  Readers load the published snapshot without taking a lock;
+ * writers serialize on a mutex, set in place when the length does not
+ * change and otherwise publish a modified copy.  Replaced snapshots are
+ * freed by epoch-based reclamation once no reader can still see them.
+*/
+
+#ifndef CONCURRENT_ARRAYLIST_H_
+#define CONCURRENT_ARRAYLIST_H_
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "../../arraylist/code/arraylist.h"
+
+#define CONCURRENT_ARRAYLIST_MAX_READERS 64
+#define CONCURRENT_ARRAYLIST_CACHE_LINE 64
+
+typedef struct ConcurrentArraylist *ConcurrentArraylist;
+struct ConcurrentReader {
+    /* Epoch observed on entering a read section, 0 when outside one */
+    _Alignas(CONCURRENT_ARRAYLIST_CACHE_LINE) unsigned long epoch;
+    bool registered;
+};
+struct ConcurrentRetired {
+    Arraylist snapshot;  /* Replaced snapshot awaiting reclamation */
+    unsigned long epoch;  /* Global epoch when it was replaced */
+    struct ConcurrentRetired *next;
+};
+struct ConcurrentArraylist {
+    Arraylist current;  /* Published snapshot */
+    _Alignas(CONCURRENT_ARRAYLIST_CACHE_LINE) unsigned long epoch;
+    struct ConcurrentReader readers[CONCURRENT_ARRAYLIST_MAX_READERS];
+    struct ConcurrentRetired *retired;
+    pthread_mutex_t writer;
+};
+
+/* Initialize/Free */
+ConcurrentArraylist concurrent_arraylist_init(const int initial_len);
+void concurrent_arraylist_free(const ConcurrentArraylist c);
+
+/* Readers */
+int concurrent_arraylist_register(const ConcurrentArraylist c);
+void concurrent_arraylist_unregister(const ConcurrentArraylist c, const int reader);
+void concurrent_arraylist_read_begin(const ConcurrentArraylist c, const int reader);
+void concurrent_arraylist_read_end(const ConcurrentArraylist c, const int reader);
+Value concurrent_arraylist_get(const ConcurrentArraylist c, const int index);
+int concurrent_arraylist_length(const ConcurrentArraylist c);
+
+/* Writers */
+Value concurrent_arraylist_set(const ConcurrentArraylist c, const int index, const Value value);
+Value concurrent_arraylist_push(const ConcurrentArraylist c, const int index, const Value value);
+Value concurrent_arraylist_pop(const ConcurrentArraylist c, const int index);
+ConcurrentArraylist concurrent_arraylist_resize(const ConcurrentArraylist c, const int length);
+
+#endif
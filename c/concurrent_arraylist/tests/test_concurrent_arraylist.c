@@ -0,0 +1,276 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "../code/concurrent_arraylist.h"
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+typedef struct TestInt {
+    int result;
+    int expected;
+} TestInt;
+typedef struct TestValue {
+    Value result;
+    Value expected;
+} TestValue;
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_value(const Value result, const Value expected) {
+    assert(result == expected);
+}
+
+/**
+ * Case initial length is negative.
+ * Case default.
+*/
+void test_concurrent_arraylist_init() {
+    const ConcurrentArraylist inputs[] = {
+        concurrent_arraylist_init(-1),
+        concurrent_arraylist_init(5),
+    };
+
+    /* Test */
+    assert(inputs[0] == NULL);
+    assert_int(inputs[1]->current->length, 5);
+    assert_int(inputs[1]->current->capacity, 10);
+    assert(inputs[1]->epoch == 1);
+    assert(inputs[1]->retired == NULL);
+
+    /* Free */
+    concurrent_arraylist_free(inputs[1]);
+}
+
+/**
+ * Case slots available.
+ * Case slot reused after unregister.
+ * Case every slot taken.
+*/
+void test_concurrent_arraylist_register() {
+    const ConcurrentArraylist input = concurrent_arraylist_init(0);
+
+    /* Test */
+    assert_int(concurrent_arraylist_register(input), 0);
+    assert_int(concurrent_arraylist_register(input), 1);
+    concurrent_arraylist_unregister(input, 0);
+    assert_int(concurrent_arraylist_register(input), 0);
+    for (int i = 2; i < CONCURRENT_ARRAYLIST_MAX_READERS; i++) {
+        assert_int(concurrent_arraylist_register(input), i);
+    }
+    assert_int(concurrent_arraylist_register(input), -1);
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+/**
+ * Case invalid index.
+ * Case default.
+*/
+void test_concurrent_arraylist_get() {
+    int value = 7;
+    const ConcurrentArraylist input = concurrent_arraylist_init(3);
+    const int reader = concurrent_arraylist_register(input);
+    input->current->array[2] = &value;
+
+    concurrent_arraylist_read_begin(input, reader);
+    const TestValue tests[] = {
+        { concurrent_arraylist_get(input, 3), NULL },
+        { concurrent_arraylist_get(input, 2), &value },
+    };
+    concurrent_arraylist_read_end(input, reader);
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    for (int i = 0; i < num_tests; i++) {
+        assert_value(tests[i].result, tests[i].expected);
+    }
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+/**
+ * Case index below 0.
+ * Case index within length (in place).
+ * Case index past length (published copy).
+*/
+void test_concurrent_arraylist_set() {
+    int value = 7;
+    const ConcurrentArraylist input = concurrent_arraylist_init(5);
+    const Arraylist original = input->current;
+
+    /* Test */
+    assert_value(concurrent_arraylist_set(input, -1, &value), NULL);
+    assert_value(concurrent_arraylist_set(input, 3, &value), &value);
+    assert(input->current == original);
+    assert_value(concurrent_arraylist_set(input, 10, &value), &value);
+    assert(input->current != original);
+    assert_int(concurrent_arraylist_length(input), 11);
+    assert_value(concurrent_arraylist_get(input, 3), &value);
+    assert_value(concurrent_arraylist_get(input, 10), &value);
+
+    /* No readers, so the replaced snapshot is reclaimed immediately */
+    assert(input->retired == NULL);
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+/**
+ * Case index below 0.
+ * Case default.
+*/
+void test_concurrent_arraylist_push() {
+    int values[] = { 1, 2 };
+    const ConcurrentArraylist input = concurrent_arraylist_init(0);
+
+    /* Test */
+    assert_value(concurrent_arraylist_push(input, -1, &values[0]), NULL);
+    assert_value(concurrent_arraylist_push(input, 0, &values[0]), &values[0]);
+    assert_value(concurrent_arraylist_push(input, 1, &values[1]), &values[1]);
+    assert_int(concurrent_arraylist_length(input), 2);
+    assert_value(concurrent_arraylist_get(input, 0), &values[0]);
+    assert_value(concurrent_arraylist_get(input, 1), &values[1]);
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+/**
+ * Case invalid index.
+ * Case default.
+*/
+void test_concurrent_arraylist_pop() {
+    int values[] = { 1, 2 };
+    const ConcurrentArraylist input = concurrent_arraylist_init(0);
+    concurrent_arraylist_push(input, 0, &values[0]);
+    concurrent_arraylist_push(input, 1, &values[1]);
+
+    /* Test */
+    assert_value(concurrent_arraylist_pop(input, 2), NULL);
+    assert_value(concurrent_arraylist_pop(input, 1), &values[1]);
+    assert_int(concurrent_arraylist_length(input), 1);
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+/**
+ * Case length is negative.
+ * Case default.
+*/
+void test_concurrent_arraylist_resize() {
+    const ConcurrentArraylist input = concurrent_arraylist_init(0);
+
+    /* Test */
+    assert(concurrent_arraylist_resize(input, -1) == NULL);
+    assert(concurrent_arraylist_resize(input, 20) == input);
+    assert_int(concurrent_arraylist_length(input), 20);
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+/**
+ * Case snapshot retained while a reader is inside a read section.
+ * Case snapshot reclaimed after the reader leaves.
+*/
+void test_concurrent_arraylist_reclaim() {
+    int value = 7;
+    const ConcurrentArraylist input = concurrent_arraylist_init(1);
+    const int reader = concurrent_arraylist_register(input);
+
+    /* Test */
+    concurrent_arraylist_read_begin(input, reader);
+    const Arraylist seen = input->current;
+    concurrent_arraylist_push(input, 0, &value);
+    assert(input->retired != NULL);
+    assert(input->retired->snapshot == seen);
+    assert_int(seen->length, 1);
+    concurrent_arraylist_read_end(input, reader);
+
+    concurrent_arraylist_push(input, 0, &value);
+    assert(input->retired == NULL);
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+/**
+ * Case readers scan while a writer pushes and sets concurrently.
+*/
+#define STRESS_READERS 4
+#define STRESS_WRITES 2000
+int stress_values[STRESS_WRITES];
+int stress_done = 0;
+void *stress_reader(void *input) {
+    const ConcurrentArraylist c = input;
+    const int reader = concurrent_arraylist_register(c);
+
+    while (!__atomic_load_n(&stress_done, __ATOMIC_ACQUIRE)) {
+        concurrent_arraylist_read_begin(c, reader);
+        const int length = concurrent_arraylist_length(c);
+        for (int i = 0; i < length; i++) {
+            int *value = concurrent_arraylist_get(c, i);
+            assert(value == NULL || (value >= stress_values && value < stress_values + STRESS_WRITES));
+        }
+        concurrent_arraylist_read_end(c, reader);
+    }
+
+    concurrent_arraylist_unregister(c, reader);
+    return NULL;
+}
+void test_concurrent_arraylist_stress() {
+    const ConcurrentArraylist input = concurrent_arraylist_init(0);
+    pthread_t readers[STRESS_READERS];
+    stress_done = 0;
+
+    for (int i = 0; i < STRESS_READERS; i++) {
+        pthread_create(&readers[i], NULL, stress_reader, input);
+    }
+    for (int i = 0; i < STRESS_WRITES; i++) {
+        concurrent_arraylist_push(input, i, &stress_values[i]);
+        concurrent_arraylist_set(input, i / 2, &stress_values[i]);
+    }
+    __atomic_store_n(&stress_done, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < STRESS_READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    /* Test */
+    assert_int(concurrent_arraylist_length(input), STRESS_WRITES);
+    assert_value(concurrent_arraylist_get(input, STRESS_WRITES - 1), &stress_values[STRESS_WRITES - 1]);
+
+    /* Free */
+    concurrent_arraylist_free(input);
+}
+
+const UnitTest TESTS[] = {
+    { test_concurrent_arraylist_init, "test_concurrent_arraylist_init" },
+    { test_concurrent_arraylist_register, "test_concurrent_arraylist_register" },
+    { test_concurrent_arraylist_get, "test_concurrent_arraylist_get" },
+    { test_concurrent_arraylist_set, "test_concurrent_arraylist_set" },
+    { test_concurrent_arraylist_push, "test_concurrent_arraylist_push" },
+    { test_concurrent_arraylist_pop, "test_concurrent_arraylist_pop" },
+    { test_concurrent_arraylist_resize, "test_concurrent_arraylist_resize" },
+    { test_concurrent_arraylist_reclaim, "test_concurrent_arraylist_reclaim" },
+    { test_concurrent_arraylist_stress, "test_concurrent_arraylist_stress" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
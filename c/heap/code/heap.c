@@ -0,0 +1,301 @@
+/**
+ * Implementation file for Heap.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "heap.h"
+
+static void sift_up(const Heap h, int index, const Value value);
+static void sift_down(const Heap h, int index, const Value value);
+static void place(const Heap h, const int index, const Value value);
+
+/**
+ * Initialized a new, empty Heap.
+ *
+ * Inputs:
+ *     const int arity: Children of each element, at least 2.
+ *                      HEAP_DEFAULT_ARITY keeps siblings on one cache line.
+ *     int (*compare)(Value, Value, void *): Negative if the first Value
+ *                                           comes out before the second.
+ *     void (*moved)(Value, int, void *): Called with a Value's new index
+ *                                        whenever it moves, may be NULL.
+ *     void *context: Passed to compare and moved.
+ * Returns:
+ *     Heap: NULL if the process fails,
+ *           Heap that is newly created otherwise.
+*/
+Heap heap_init(const int arity, int (*compare)(Value, Value, void *), void (*moved)(Value, int, void *), void *context) {
+    if (arity < 2 || compare == NULL) {
+        return NULL;
+    }
+
+    /* Malloc */
+    Heap h = malloc(sizeof(*h));
+    Arraylist array = arraylist_init(0);
+
+    if (h == NULL || array == NULL) {
+        free(h);
+        arraylist_free(array);
+        return NULL;
+    }
+
+    /* Initialize */
+    h->array = array;
+    h->arity = arity;
+    h->compare = compare;
+    h->moved = moved;
+    h->context = context;
+
+    return h;
+}
+
+/**
+ * Free a Heap.  The Values themselves are not freed.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ * Returns:
+ *     Nothing.
+*/
+void heap_free(const Heap h) {
+    if (h) {
+        arraylist_free(h->array);
+        free(h);
+    }
+}
+
+/**
+ * Query whether the Heap has a length of 0.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ * Returns:
+ *     bool: Whether the Heap has a length of 0.
+*/
+bool heap_empty(const Heap h) {
+    return h->array->length == 0;
+}
+
+/**
+ * Get the length of the elements of a Heap.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ * Returns:
+ *     int: The length of the elements in the Heap.
+*/
+int heap_length(const Heap h) {
+    return h->array->length;
+}
+
+/**
+ * Get the Value that comes out first without removing it.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ * Returns:
+ *     Value: NULL if the Heap is empty,
+ *            first Value otherwise.
+*/
+Value heap_peek(const Heap h) {
+    return h->array->length ? h->array->array[0] : NULL;
+}
+
+/**
+ * Remove and return the Value that comes out first.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ * Returns:
+ *     Value: NULL if the Heap is empty,
+ *            first Value otherwise.
+*/
+Value heap_pop(const Heap h) {
+    return heap_remove(h, 0);
+}
+
+/**
+ * Add a Value to the Heap.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ *     const Value value: The Value to add.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+Value heap_push(const Heap h, const Value value) {
+    /* Grow once, then sift on the internal array */
+    const int index = h->array->length;
+    if (!arraylist_resize(h->array, index + 1)) {
+        return NULL;
+    }
+
+    sift_up(h, index, value);
+    return value;
+}
+
+/**
+ * Remove the Value at an index of the Heap.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ *     const int index: The index to remove, as reported to moved.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was removed otherwise.
+*/
+Value heap_remove(const Heap h, const int index) {
+    const int length = h->array->length;
+    if (index < 0 || index >= length) {
+        return NULL;
+    }
+
+    /* Shrink once, then fill the hole with the last Value */
+    const Value value = h->array->array[index];
+    const Value last = h->array->array[length - 1];
+    if (!arraylist_resize(h->array, length - 1)) {
+        return NULL;
+    }
+    if (index < length - 1) {
+        place(h, index, last);
+    }
+    return value;
+}
+
+/**
+ * Restore heap order after the priority of the Value at an index changed,
+ * for both decrease-key and increase-key.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ *     const int index: The index of the changed Value, as reported to moved.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was updated otherwise.
+*/
+Value heap_update(const Heap h, const int index) {
+    if (index < 0 || index >= h->array->length) {
+        return NULL;
+    }
+
+    const Value value = h->array->array[index];
+    place(h, index, value);
+    return value;
+}
+
+/**
+ * Reorder every element of the Heap's Arraylist into heap order in O(N),
+ * for Values loaded in bulk with arraylist_set or arraylist_push.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ * Returns:
+ *     Heap: h.
+*/
+Heap heapify(const Heap h) {
+    const int length = h->array->length;
+    for (int i = (length - 2) / h->arity; i >= 0 && length > 1; i--) {
+        sift_down(h, i, h->array->array[i]);
+    }
+
+    /* Report every index, unmoved Values included */
+    for (int i = 0; h->moved && i < length; i++) {
+        h->moved(h->array->array[i], i, h->context);
+    }
+    return h;
+}
+
+/**
+ * Move a Value from a hole towards the root until its parent comes first.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ *     int index: The hole to start at.
+ *     const Value value: The Value to place.
+ * Returns:
+ *     Nothing.
+*/
+static void sift_up(const Heap h, int index, const Value value) {
+    Value *array = h->array->array;
+    while (index > 0) {
+        const int parent = (index - 1) / h->arity;
+        if (h->compare(value, array[parent], h->context) >= 0) {
+            break;
+        }
+        array[index] = array[parent];
+        if (h->moved) {
+            h->moved(array[index], index, h->context);
+        }
+        index = parent;
+    }
+
+    array[index] = value;
+    if (h->moved) {
+        h->moved(value, index, h->context);
+    }
+}
+
+/**
+ * Move a Value from a hole towards the leaves until it comes before
+ * all of its children.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ *     int index: The hole to start at.
+ *     const Value value: The Value to place.
+ * Returns:
+ *     Nothing.
+*/
+static void sift_down(const Heap h, int index, const Value value) {
+    Value *array = h->array->array;
+    const int length = h->array->length;
+    while (true) {
+        /* First of the children */
+        const int first = index * h->arity + 1;
+        if (first >= length) {
+            break;
+        }
+        const int end = (length - first < h->arity) ? length : first + h->arity;
+        int best = first;
+        for (int child = first + 1; child < end; child++) {
+            if (h->compare(array[child], array[best], h->context) < 0) {
+                best = child;
+            }
+        }
+
+        if (h->compare(array[best], value, h->context) >= 0) {
+            break;
+        }
+        array[index] = array[best];
+        if (h->moved) {
+            h->moved(array[index], index, h->context);
+        }
+        index = best;
+    }
+
+    array[index] = value;
+    if (h->moved) {
+        h->moved(value, index, h->context);
+    }
+}
+
+/**
+ * Place a Value into a hole, sifting whichever way heap order needs.
+ *
+ * Inputs:
+ *     const Heap h: Heap to use.
+ *     const int index: The hole to fill.
+ *     const Value value: The Value to place.
+ * Returns:
+ *     Nothing.
+*/
+static void place(const Heap h, const int index, const Value value) {
+    const int parent = (index - 1) / h->arity;
+    if (index > 0 && h->compare(value, h->array->array[parent], h->context) < 0) {
+        sift_up(h, index, value);
+    } else {
+        sift_down(h, index, value);
+    }
+}
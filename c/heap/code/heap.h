@@ -0,0 +1,43 @@
+/**
+ * Header file for Heap.
+ *
+ * A d-ary min-heap priority queue stored in an Arraylist.  Priority is
+ * decided by a comparator with a caller context, and an optional moved
+ * callback reports every element's new index so callers can track
+ * positions for heap_update and heap_remove.
+*/
+
+#ifndef HEAP_H_
+#define HEAP_H_
+
+#include <stdbool.h>
+#include "../../arraylist/code/arraylist.h"
+
+#define HEAP_DEFAULT_ARITY 4
+
+typedef struct Heap *Heap;
+struct Heap {
+    Arraylist array;  /* Elements in heap order */
+    int arity;  /* Children of each element */
+    int (*compare)(Value, Value, void *);  /* Negative if the first comes out first */
+    void (*moved)(Value, int, void *);  /* Called with a Value's new index, or NULL */
+    void *context;  /* Passed to compare and moved */
+};
+
+/* Initialize/Free */
+Heap heap_init(const int arity, int (*compare)(Value, Value, void *), void (*moved)(Value, int, void *), void *context);
+void heap_free(const Heap h);
+
+/* Get/Remove elements */
+bool heap_empty(const Heap h);
+int heap_length(const Heap h);
+Value heap_peek(const Heap h);
+Value heap_pop(const Heap h);
+Value heap_push(const Heap h, const Value value);
+Value heap_remove(const Heap h, const int index);
+
+/* Restore order */
+Value heap_update(const Heap h, const int index);
+Heap heapify(const Heap h);
+
+#endif
@@ -0,0 +1,198 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include "../code/heap.h"
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+
+/* Timer event with a tracked heap position */
+typedef struct Event {
+    int key;
+    int index;
+} Event;
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_value(const Value result, const Value expected) {
+    assert(result == expected);
+}
+
+int compare_fn(Value a, Value b, void *context) {
+    (*(int *)context)++;
+    return ((Event *)a)->key - ((Event *)b)->key;
+}
+
+void moved_fn(Value value, int index, void *context) {
+    ((Event *)value)->index = index;
+}
+
+void assert_heap(const Heap h) {
+    Value *array = h->array->array;
+    for (int i = 1; i < h->array->length; i++) {
+        assert(((Event *)array[(i - 1) / h->arity])->key <= ((Event *)array[i])->key);
+    }
+    for (int i = 0; i < h->array->length; i++) {
+        assert_int(((Event *)array[i])->index, i);
+    }
+}
+
+/**
+ * Case arity below 2.
+ * Case no comparator.
+ * Case default.
+*/
+void test_heap_init() {
+    int comparisons = 0;
+    const Heap inputs[] = {
+        heap_init(1, compare_fn, moved_fn, &comparisons),
+        heap_init(2, NULL, moved_fn, &comparisons),
+        heap_init(HEAP_DEFAULT_ARITY, compare_fn, NULL, &comparisons),
+    };
+
+    /* Test */
+    assert(inputs[0] == NULL);
+    assert(inputs[1] == NULL);
+    assert(heap_empty(inputs[2]));
+    assert_int(heap_length(inputs[2]), 0);
+    assert_value(heap_peek(inputs[2]), NULL);
+    assert_value(heap_pop(inputs[2]), NULL);
+
+    /* Free */
+    heap_free(inputs[2]);
+}
+
+/**
+ * Case values come out in key order for several arities.
+*/
+void test_heap_push_pop() {
+    const int arities[] = { 2, 3, 4, 8 };
+    Event events[100];
+
+    for (int a = 0; a < 4; a++) {
+        int comparisons = 0;
+        const Heap input = heap_init(arities[a], compare_fn, moved_fn, &comparisons);
+        for (int i = 0; i < 100; i++) {
+            events[i] = (Event){ (i * 37) % 100, -1 };
+            assert_value(heap_push(input, &events[i]), &events[i]);
+        }
+
+        /* Test */
+        assert_int(heap_length(input), 100);
+        assert_heap(input);
+        for (int i = 0; i < 100; i++) {
+            assert_int(((Event *)heap_peek(input))->key, i);
+            assert_int(((Event *)heap_pop(input))->key, i);
+            assert_heap(input);
+        }
+        assert(heap_empty(input));
+
+        /* Free */
+        heap_free(input);
+    }
+}
+
+/**
+ * Case decrease key moves towards the root.
+ * Case increase key moves towards the leaves.
+ * Case invalid index.
+*/
+void test_heap_update() {
+    int comparisons = 0;
+    Event events[50];
+    const Heap input = heap_init(HEAP_DEFAULT_ARITY, compare_fn, moved_fn, &comparisons);
+    for (int i = 0; i < 50; i++) {
+        events[i] = (Event){ i + 10, -1 };
+        heap_push(input, &events[i]);
+    }
+
+    /* Test */
+    events[40].key = 0;
+    assert_value(heap_update(input, events[40].index), &events[40]);
+    assert_value(heap_peek(input), &events[40]);
+    assert_heap(input);
+    events[40].key = 100;
+    assert_value(heap_update(input, events[40].index), &events[40]);
+    assert_value(heap_peek(input), &events[0]);
+    assert_heap(input);
+    assert_value(heap_update(input, 50), NULL);
+
+    /* Free */
+    heap_free(input);
+}
+
+/**
+ * Case remove from the middle.
+ * Case remove last.
+ * Case invalid index.
+*/
+void test_heap_remove() {
+    int comparisons = 0;
+    Event events[20];
+    const Heap input = heap_init(2, compare_fn, moved_fn, &comparisons);
+    for (int i = 0; i < 20; i++) {
+        events[i] = (Event){ 20 - i, -1 };
+        heap_push(input, &events[i]);
+    }
+
+    /* Test */
+    assert_value(heap_remove(input, events[7].index), &events[7]);
+    assert_int(heap_length(input), 19);
+    assert_heap(input);
+    const Value last = input->array->array[18];
+    assert_value(heap_remove(input, 18), last);
+    assert_int(heap_length(input), 18);
+    assert_heap(input);
+    assert_value(heap_remove(input, -1), NULL);
+
+    /* Free */
+    heap_free(input);
+}
+
+/**
+ * Case bulk loaded values are ordered with O(N) comparisons.
+*/
+void test_heapify() {
+    int comparisons = 0;
+    const int length = 10000;
+    Event *events = malloc(length * sizeof(*events));
+    const Heap input = heap_init(HEAP_DEFAULT_ARITY, compare_fn, moved_fn, &comparisons);
+    for (int i = 0; i < length; i++) {
+        events[i] = (Event){ (i * 7919) % length, -1 };
+        arraylist_set(input->array, i, &events[i]);
+    }
+
+    /* Test */
+    assert(heapify(input) == input);
+    assert_heap(input);
+    assert(comparisons < 3 * length);
+    for (int i = 0; i < length; i++) {
+        assert_int(((Event *)heap_pop(input))->key, i);
+    }
+
+    /* Free */
+    heap_free(input);
+    free(events);
+}
+
+const UnitTest TESTS[] = {
+    { test_heap_init, "test_heap_init" },
+    { test_heap_push_pop, "test_heap_push_pop" },
+    { test_heap_update, "test_heap_update" },
+    { test_heap_remove, "test_heap_remove" },
+    { test_heapify, "test_heapify" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
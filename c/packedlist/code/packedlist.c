@@ -0,0 +1,424 @@
+/**
+ * Implementation file for Packedlist.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "packedlist.h"
+
+#define WORD_BITS 64
+#define LANES 4  /* Values i, i + LANES, ... share a lane of words */
+#define ROWS (PACKEDLIST_BLOCK_LEN / LANES)
+
+#if defined(__GNUC__)
+/* One word from each lane, shifted together by the SIMD unit */
+typedef uint64_t PackedLanes __attribute__((vector_size(LANES * sizeof(uint64_t))));
+#endif
+
+static const int MIN_CAPACITY = 10;
+
+static Packedlist pack_tail(const Packedlist p);
+static int bit_width(const uint64_t value);
+static uint64_t width_mask(const int width);
+static int block_words(const int width);
+static int locate(const int i, const int width, int *shift);
+static void unpack(const uint64_t *words, const int width, uint64_t *out);
+
+/**
+ * Initialized a new, empty Packedlist.
+ *
+ * Inputs:
+ *     None.
+ * Returns:
+ *     Packedlist: NULL if the process fails,
+ *                 Packedlist that is newly created otherwise.
+*/
+Packedlist packedlist_init(void) {
+    /* Malloc */
+    Packedlist p = malloc(sizeof(*p));
+    struct PackedBlock *blocks = malloc(MIN_CAPACITY * sizeof(*blocks));
+    uint64_t *words = calloc(MIN_CAPACITY + LANES, sizeof(*words));
+
+    if (p == NULL || blocks == NULL || words == NULL) {
+        free(p);
+        free(blocks);
+        free(words);
+        return NULL;
+    }
+
+    /* Initialize */
+    p->length = 0;
+    p->num_blocks = 0;
+    p->block_capacity = MIN_CAPACITY;
+    p->blocks = blocks;
+    p->num_words = 0;
+    p->word_capacity = MIN_CAPACITY;
+    p->words = words;
+
+    return p;
+}
+
+/**
+ * Free a Packedlist.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ * Returns:
+ *     Nothing.
+*/
+void packedlist_free(const Packedlist p) {
+    if (p) {
+        free(p->blocks);
+        free(p->words);
+        free(p);
+    }
+}
+
+/**
+ * Query whether the Packedlist has a length of 0.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ * Returns:
+ *     bool: Whether the Packedlist has a length of 0.
+*/
+bool packedlist_empty(const Packedlist p) {
+    return p->length == 0;
+}
+
+/**
+ * Get an index's value from a Packedlist.  Frame of reference blocks
+ * decode one value in O(1); delta blocks sum the gaps up to the index,
+ * up to PACKEDLIST_BLOCK_LEN of them per call, so sequential reads
+ * should use packedlist_decode_block or packedlist_foreach instead.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ *     const int index: The index to access.
+ *     uint64_t *value: Where to write the value.
+ * Returns:
+ *     bool: Whether the index is in range and value was written.
+*/
+bool packedlist_get(const Packedlist p, const int index, uint64_t *value) {
+    if (index < 0 || index >= p->length) {
+        return false;
+    }
+
+    /* Not yet packed */
+    const int block_index = index / PACKEDLIST_BLOCK_LEN;
+    const int position = index % PACKEDLIST_BLOCK_LEN;
+    if (block_index == p->num_blocks) {
+        *value = p->tail[position];
+        return true;
+    }
+
+    /* Skip straight to the block */
+    const struct PackedBlock *block = &p->blocks[block_index];
+    if (block->width == 0) {
+        *value = block->base;
+        return true;
+    }
+    const uint64_t *words = p->words + block->offset;
+    const uint64_t mask = width_mask(block->width);
+    const int first = block->delta ? 0 : position;
+    uint64_t sum = block->base;
+    for (int i = first; i <= position; i++) {
+        int shift;
+        const int word = locate(i, block->width, &shift);
+        const uint64_t low = words[word] >> shift;
+        const uint64_t high = (words[word + LANES] << 1) << (WORD_BITS - 1 - shift);
+        sum += (low | high) & mask;
+    }
+
+    *value = sum;
+    return true;
+}
+
+/**
+ * Append a value, packing the tail once it fills a block.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ *     const uint64_t value: The value to append.
+ * Returns:
+ *     Packedlist: NULL if the process fails,
+ *                 Packedlist otherwise.
+*/
+Packedlist packedlist_push_back(const Packedlist p, const uint64_t value) {
+    const int position = p->length % PACKEDLIST_BLOCK_LEN;
+    p->tail[position] = value;
+    p->length++;
+
+    if (position == PACKEDLIST_BLOCK_LEN - 1 && !pack_tail(p)) {
+        p->length--;
+        return NULL;
+    }
+    return p;
+}
+
+/**
+ * Get the length of the elements of a Packedlist.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ * Returns:
+ *     int: The length of the elements in the Packedlist.
+*/
+int packedlist_length(const Packedlist p) {
+    return p->length;
+}
+
+/**
+ * Get the bytes held by a Packedlist, including unused capacity.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ * Returns:
+ *     size_t: Bytes allocated for the Packedlist.
+*/
+size_t packedlist_memory(const Packedlist p) {
+    return sizeof(*p)
+        + p->block_capacity * sizeof(*p->blocks)
+        + (p->word_capacity + LANES) * sizeof(*p->words);
+}
+
+/**
+ * Decode every value of a block, the last block being the unpacked tail.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ *     const int block: Index of the block, 0 to ceil(length / BLOCK_LEN) - 1.
+ *     uint64_t *out: Where to write up to PACKEDLIST_BLOCK_LEN values.
+ * Returns:
+ *     int: -1 if the block is out of range,
+ *          number of values written otherwise.
+*/
+int packedlist_decode_block(const Packedlist p, const int block, uint64_t *out) {
+    const int tail_length = p->length - p->num_blocks * PACKEDLIST_BLOCK_LEN;
+    if (block < 0 || block > p->num_blocks || (block == p->num_blocks && tail_length == 0)) {
+        return -1;
+    }
+
+    /* Not yet packed */
+    if (block == p->num_blocks) {
+        memcpy(out, p->tail, tail_length * sizeof(*out));
+        return tail_length;
+    }
+
+    /* Unpack, then add the base or running sum */
+    const struct PackedBlock *b = &p->blocks[block];
+    unpack(p->words + b->offset, b->width, out);
+    if (b->delta) {
+        uint64_t sum = b->base;
+        for (int i = 0; i < PACKEDLIST_BLOCK_LEN; i++) {
+            sum += out[i];
+            out[i] = sum;
+        }
+    } else {
+        for (int i = 0; i < PACKEDLIST_BLOCK_LEN; i++) {
+            out[i] += b->base;
+        }
+    }
+    return PACKEDLIST_BLOCK_LEN;
+}
+
+/**
+ * Calls a function once for each element in the Packedlist,
+ * from indices 0 to length - 1, decoding a block at a time.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ *     void (*f)(uint64_t): Function to call for each element.
+ * Returns:
+ *     Nothing.
+*/
+void packedlist_foreach(const Packedlist p, void (*f)(uint64_t)) {
+    uint64_t values[PACKEDLIST_BLOCK_LEN];
+    const int num_blocks =
+        (p->length + PACKEDLIST_BLOCK_LEN - 1) / PACKEDLIST_BLOCK_LEN;
+
+    for (int block = 0; block < num_blocks; block++) {
+        const int length = packedlist_decode_block(p, block, values);
+        for (int i = 0; i < length; i++) {
+            f(values[i]);
+        }
+    }
+}
+
+/**
+ * Pack the full tail into a new block using the narrower of frame of
+ * reference and delta encoding.
+ *
+ * Inputs:
+ *     const Packedlist p: Packedlist to use.
+ * Returns:
+ *     Packedlist: NULL if the process fails,
+ *                 Packedlist otherwise.
+*/
+static Packedlist pack_tail(const Packedlist p) {
+    /* Choose encoding */
+    uint64_t min = p->tail[0];
+    uint64_t max = p->tail[0];
+    uint64_t max_gap = 0;
+    bool sorted = true;
+    for (int i = 1; i < PACKEDLIST_BLOCK_LEN; i++) {
+        const uint64_t value = p->tail[i];
+        min = value < min ? value : min;
+        max = value > max ? value : max;
+        sorted = sorted && value >= p->tail[i - 1];
+        const uint64_t gap = value - p->tail[i - 1];
+        max_gap = gap > max_gap ? gap : max_gap;
+    }
+    const int reference_width = bit_width(max - min);
+    const int delta_width = sorted ? bit_width(max_gap) : WORD_BITS + 1;
+    const bool delta = delta_width < reference_width;
+    const int width = delta ? delta_width : reference_width;
+    const int num_words = block_words(width);
+
+    /* Grow blocks */
+    if (p->num_blocks == p->block_capacity) {
+        const int capacity = p->block_capacity * 2;
+        struct PackedBlock *blocks = realloc(p->blocks, capacity * sizeof(*blocks));
+        if (!blocks) {
+            return NULL;
+        }
+        p->block_capacity = capacity;
+        p->blocks = blocks;
+    }
+
+    /* Grow words, keeping a zero word past the end of each lane */
+    if (p->num_words + num_words > p->word_capacity) {
+        int capacity = p->word_capacity * 2;
+        if (capacity < p->num_words + num_words) {
+            capacity = p->num_words + num_words;
+        }
+        uint64_t *words = realloc(p->words, (capacity + LANES) * sizeof(*words));
+        if (!words) {
+            return NULL;
+        }
+        p->word_capacity = capacity;
+        p->words = words;
+    }
+    uint64_t *words = p->words + p->num_words;
+    memset(words, 0, (num_words + LANES) * sizeof(*words));
+
+    /* Pack */
+    const uint64_t base = delta ? p->tail[0] : min;
+    for (int i = 0; i < PACKEDLIST_BLOCK_LEN && width > 0; i++) {
+        const uint64_t value =
+            delta
+            ? (i == 0 ? 0 : p->tail[i] - p->tail[i - 1])
+            : p->tail[i] - min;
+        int shift;
+        const int word = locate(i, width, &shift);
+        words[word] |= value << shift;
+        if (shift + width > WORD_BITS) {
+            words[word + LANES] |= value >> (WORD_BITS - shift);
+        }
+    }
+
+    p->blocks[p->num_blocks] = (struct PackedBlock){
+        base, p->num_words, width, delta
+    };
+    p->num_blocks++;
+    p->num_words += num_words;
+    return p;
+}
+
+/**
+ * Number of bits needed to hold a value.
+ *
+ * Inputs:
+ *     const uint64_t value: Value to measure.
+ * Returns:
+ *     int: 0 to 64.
+*/
+static int bit_width(const uint64_t value) {
+    return value == 0 ? 0 : WORD_BITS - __builtin_clzll(value);
+}
+
+/**
+ * Mask of the low bits of a packed value.
+ *
+ * Inputs:
+ *     const int width: Bits per packed value, 0 to 64.
+ * Returns:
+ *     uint64_t: Mask of the low width bits.
+*/
+static uint64_t width_mask(const int width) {
+    return width == WORD_BITS ? UINT64_MAX : ((uint64_t)1 << width) - 1;
+}
+
+/**
+ * Number of words a block of a width packs into.  Each lane packs ROWS
+ * values into whole words, so odd widths leave half a word per lane.
+ *
+ * Inputs:
+ *     const int width: Bits per packed value, 0 to 64.
+ * Returns:
+ *     int: Words in the block.
+*/
+static int block_words(const int width) {
+    return LANES * ((ROWS * width + WORD_BITS - 1) / WORD_BITS);
+}
+
+/**
+ * Find where a packed value starts.  Value i is row i / LANES of lane
+ * i % LANES, and word k of each lane is stored at k * LANES + lane, so
+ * a row's values sit side by side with the same shift.  Bits past the
+ * word continue in the lane's next word, LANES words further on.
+ *
+ * Inputs:
+ *     const int i: Position of the value in its block.
+ *     const int width: Bits per packed value.
+ *     int *shift: Where to write the bit offset in the word.
+ * Returns:
+ *     int: Index of the word holding the low bits.
+*/
+static int locate(const int i, const int width, int *shift) {
+    const int bit = (i / LANES) * width;
+    *shift = bit % WORD_BITS;
+    return bit / WORD_BITS * LANES + i % LANES;
+}
+
+/**
+ * Unpack a block of values a row at a time.  Every value of a row
+ * shifts by the same amount, so a row is a few SIMD shifts where GCC
+ * vector extensions are available and a scalar loop otherwise.  Reads
+ * at most one row of words past the block.
+ *
+ * Inputs:
+ *     const uint64_t *words: First word of the block.
+ *     const int width: Bits per packed value.
+ *     uint64_t *out: Where to write PACKEDLIST_BLOCK_LEN values.
+ * Returns:
+ *     Nothing.
+*/
+static void unpack(const uint64_t *words, const int width, uint64_t *out) {
+    if (width == 0) {
+        memset(out, 0, PACKEDLIST_BLOCK_LEN * sizeof(*out));
+        return;
+    }
+
+    const uint64_t mask = width_mask(width);
+    for (int row = 0; row < ROWS; row++) {
+        int shift;
+        const uint64_t *low = words + locate(row * LANES, width, &shift);
+        const uint64_t *high = low + LANES;
+#if defined(__GNUC__)
+        PackedLanes low_lanes, high_lanes;
+        memcpy(&low_lanes, low, sizeof(low_lanes));
+        memcpy(&high_lanes, high, sizeof(high_lanes));
+        const PackedLanes values =
+            ((low_lanes >> shift) | ((high_lanes << 1) << (WORD_BITS - 1 - shift))) & mask;
+        memcpy(out + row * LANES, &values, sizeof(values));
+#else
+        for (int lane = 0; lane < LANES; lane++) {
+            const uint64_t value = (low[lane] >> shift) | ((high[lane] << 1) << (WORD_BITS - 1 - shift));
+            out[row * LANES + lane] = value & mask;
+        }
+#endif
+    }
+}
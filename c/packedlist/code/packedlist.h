@@ -0,0 +1,56 @@
+/**
+ * Header file for Packedlist.
+ *
+ * An append-only list of 64-bit integers compressed in blocks of
+ * PACKEDLIST_BLOCK_LEN values.  Each block is bit-packed either as
+ * offsets from its minimum (frame of reference) or, when its values
+ * are sorted, as gaps between neighbours (delta), whichever is narrower.
+ * Packed values are interleaved across four lanes of words, so a block
+ * decodes with SIMD shifts of four values at a time.
+*/
+
+#ifndef PACKEDLIST_H_
+#define PACKEDLIST_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PACKEDLIST_BLOCK_LEN 128
+
+typedef struct Packedlist *Packedlist;
+struct PackedBlock {
+    uint64_t base;  /* Minimum value, or first value if delta */
+    int offset;  /* Index of the first word of the block */
+    unsigned char width;  /* Bits per packed value */
+    bool delta;  /* Whether packed values are gaps between neighbours */
+};
+struct Packedlist {
+    int length;  /* Length of elements */
+    int num_blocks;  /* Length of packed blocks */
+    int block_capacity;  /* Length of internal block array */
+    struct PackedBlock *blocks;  /* Skip index, one entry per packed block */
+    int num_words;  /* Length of packed words */
+    int word_capacity;  /* Length of internal word array */
+    uint64_t *words;  /* Packed bits, followed by one zero word per lane */
+    uint64_t tail[PACKEDLIST_BLOCK_LEN];  /* Values not yet packed */
+};
+
+/* Initialize/Free */
+Packedlist packedlist_init(void);
+void packedlist_free(const Packedlist p);
+
+/* Get/Add elements */
+bool packedlist_empty(const Packedlist p);
+bool packedlist_get(const Packedlist p, const int index, uint64_t *value);
+Packedlist packedlist_push_back(const Packedlist p, const uint64_t value);
+
+/* Get size */
+int packedlist_length(const Packedlist p);
+size_t packedlist_memory(const Packedlist p);
+
+/* Iterate */
+int packedlist_decode_block(const Packedlist p, const int block, uint64_t *out);
+void packedlist_foreach(const Packedlist p, void (*f)(uint64_t));
+
+#endif
@@ -0,0 +1,225 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <assert.h>
+#include "../code/packedlist.h"
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_u64(const uint64_t result, const uint64_t expected) {
+    assert(result == expected);
+}
+
+/**
+ * Case default.
+*/
+void test_packedlist_init() {
+    const Packedlist input = packedlist_init();
+
+    /* Test */
+    assert(input != NULL);
+    assert(packedlist_empty(input));
+    assert_int(packedlist_length(input), 0);
+    assert_int(input->num_blocks, 0);
+
+    /* Free */
+    packedlist_free(input);
+}
+
+/**
+ * Case tail only.
+ * Case fills a block.
+*/
+void test_packedlist_push_back() {
+    const Packedlist input = packedlist_init();
+
+    /* Test */
+    for (int i = 0; i < PACKEDLIST_BLOCK_LEN - 1; i++) {
+        assert(packedlist_push_back(input, i) == input);
+    }
+    assert_int(input->num_blocks, 0);
+    assert(packedlist_push_back(input, PACKEDLIST_BLOCK_LEN - 1) == input);
+    assert_int(input->num_blocks, 1);
+    assert_int(packedlist_length(input), PACKEDLIST_BLOCK_LEN);
+
+    /* Free */
+    packedlist_free(input);
+}
+
+/**
+ * Case invalid index.
+ * Case sorted ids pack as deltas.
+ * Case unsorted values pack as frame of reference.
+ * Case constant values pack to 0 bits.
+ * Case full 64-bit range.
+ * Case tail.
+*/
+uint64_t sorted_value(const int i) {
+    return 1000000000000ULL + (uint64_t)i * 5 + (i % 5);
+}
+uint64_t unsorted_value(const int i) {
+    return 5000 + (uint64_t)((i * 7919) % 1000);
+}
+uint64_t constant_value(const int i) {
+    return 42;
+}
+uint64_t wide_value(const int i) {
+    return i % 2 ? UINT64_MAX - i : (uint64_t)i;
+}
+void test_packedlist_get() {
+    uint64_t (*generators[])(const int) = {
+        sorted_value, unsorted_value, constant_value, wide_value,
+    };
+    const int expected_delta[] = { 1, 0, 0, 0 };
+    const int expected_width[] = { 3, 10, 0, 64 };
+    const int length = 3 * PACKEDLIST_BLOCK_LEN + 17;
+
+    for (int g = 0; g < 4; g++) {
+        const Packedlist input = packedlist_init();
+        for (int i = 0; i < length; i++) {
+            packedlist_push_back(input, generators[g](i));
+        }
+
+        /* Test */
+        uint64_t value = 0;
+        assert(!packedlist_get(input, -1, &value));
+        assert(!packedlist_get(input, length, &value));
+        assert_int(input->blocks[0].delta, expected_delta[g]);
+        assert_int(input->blocks[0].width, expected_width[g]);
+        for (int i = 0; i < length; i++) {
+            assert(packedlist_get(input, i, &value));
+            assert_u64(value, generators[g](i));
+        }
+
+        /* Free */
+        packedlist_free(input);
+    }
+}
+
+/**
+ * Case every width round-trips through get and decode_block.
+*/
+uint64_t width_value(const int i, const uint64_t top) {
+    return i < 2 ? i * top : (i * 0x9E3779B97F4A7C15ULL) & top;
+}
+void test_packedlist_widths() {
+    uint64_t values[PACKEDLIST_BLOCK_LEN];
+    for (int width = 1; width <= 64; width++) {
+        const Packedlist input = packedlist_init();
+        const uint64_t top = (width == 64) ? UINT64_MAX : ((uint64_t)1 << width) - 1;
+        for (int i = 0; i < PACKEDLIST_BLOCK_LEN; i++) {
+            packedlist_push_back(input, width_value(i, top));
+        }
+
+        /* Test */
+        assert_int(input->blocks[0].width, width);
+        assert_int(packedlist_decode_block(input, 0, values), PACKEDLIST_BLOCK_LEN);
+        for (int i = 0; i < PACKEDLIST_BLOCK_LEN; i++) {
+            uint64_t value = 0;
+            assert(packedlist_get(input, i, &value));
+            assert_u64(values[i], value);
+            assert_u64(value, width_value(i, top));
+        }
+
+        /* Free */
+        packedlist_free(input);
+    }
+}
+
+/**
+ * Case invalid block.
+ * Case packed block.
+ * Case tail block.
+*/
+void test_packedlist_decode_block() {
+    uint64_t values[PACKEDLIST_BLOCK_LEN];
+    const Packedlist input = packedlist_init();
+    for (int i = 0; i < PACKEDLIST_BLOCK_LEN + 5; i++) {
+        packedlist_push_back(input, sorted_value(i));
+    }
+
+    /* Test */
+    assert_int(packedlist_decode_block(input, -1, values), -1);
+    assert_int(packedlist_decode_block(input, 2, values), -1);
+    assert_int(packedlist_decode_block(input, 0, values), PACKEDLIST_BLOCK_LEN);
+    for (int i = 0; i < PACKEDLIST_BLOCK_LEN; i++) {
+        assert_u64(values[i], sorted_value(i));
+    }
+    assert_int(packedlist_decode_block(input, 1, values), 5);
+    for (int i = 0; i < 5; i++) {
+        assert_u64(values[i], sorted_value(PACKEDLIST_BLOCK_LEN + i));
+    }
+
+    /* Free */
+    packedlist_free(input);
+}
+
+/**
+ * Case default.
+*/
+uint64_t foreach_sum = 0;
+int foreach_counter = 0;
+void foreach_fn(uint64_t value) {
+    foreach_sum += value;
+    foreach_counter++;
+}
+void test_packedlist_foreach() {
+    const Packedlist input = packedlist_init();
+    uint64_t expected = 0;
+    for (int i = 0; i < 1000; i++) {
+        packedlist_push_back(input, sorted_value(i));
+        expected += sorted_value(i);
+    }
+
+    /* Test */
+    packedlist_foreach(input, foreach_fn);
+    assert_int(foreach_counter, 1000);
+    assert_u64(foreach_sum, expected);
+
+    /* Free */
+    packedlist_free(input);
+}
+
+/**
+ * Case sorted ids with small gaps use a fraction of inline storage.
+*/
+void test_packedlist_memory() {
+    const Packedlist input = packedlist_init();
+    const int length = 100000;
+    for (int i = 0; i < length; i++) {
+        packedlist_push_back(input, sorted_value(i));
+    }
+
+    /* Test */
+    assert(packedlist_memory(input) * 4 < length * sizeof(uint64_t));
+
+    /* Free */
+    packedlist_free(input);
+}
+
+const UnitTest TESTS[] = {
+    { test_packedlist_init, "test_packedlist_init" },
+    { test_packedlist_push_back, "test_packedlist_push_back" },
+    { test_packedlist_get, "test_packedlist_get" },
+    { test_packedlist_widths, "test_packedlist_widths" },
+    { test_packedlist_decode_block, "test_packedlist_decode_block" },
+    { test_packedlist_foreach, "test_packedlist_foreach" },
+    { test_packedlist_memory, "test_packedlist_memory" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
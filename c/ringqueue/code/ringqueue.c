@@ -0,0 +1,459 @@
+/**
+ * Implementation file for Spscqueue and Mpscqueue.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ringqueue.h"
+
+static void *cache_aligned_alloc(const size_t size);
+static int round_capacity(const int capacity);
+
+/**
+ * Malloc zeroed memory starting on a cache line, rounding the size up
+ * to whole cache lines so the last index keeps its line to itself.
+ *
+ * Inputs:
+ *     const size_t size: Size in bytes.
+ * Returns:
+ *     void *: NULL if the process fails,
+ *             memory that is newly allocated otherwise.
+*/
+static void *cache_aligned_alloc(const size_t size) {
+    const size_t alignment = RINGQUEUE_CACHE_LINE;
+    const size_t rounded = (size + alignment - 1) / alignment * alignment;
+    void *p = aligned_alloc(alignment, rounded);
+    if (p) {
+        memset(p, 0, rounded);
+    }
+    return p;
+}
+
+/**
+ * Round a capacity up to a power of two.
+ *
+ * Inputs:
+ *     const int capacity: Requested capacity.
+ * Returns:
+ *     int: -1 if the capacity is invalid,
+ *          smallest power of two not below capacity otherwise.
+*/
+static int round_capacity(const int capacity) {
+    if (capacity < 1 || capacity > RINGQUEUE_MAX_CAPACITY) {
+        return -1;
+    }
+    int rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+/**
+ * Initialized a new Spscqueue.
+ *
+ * Inputs:
+ *     const int capacity: Minimum number of Values held, rounded up to a power of two.
+ * Returns:
+ *     Spscqueue: NULL if the process fails,
+ *                Spscqueue that is newly created otherwise.
+*/
+Spscqueue spscqueue_init(const int capacity) {
+    const int rounded = round_capacity(capacity);
+    if (rounded < 0) {
+        return NULL;
+    }
+
+    /*
+     * The Arraylist is only storage, its length is the ring capacity.
+     * Reserving directly skips the fill-ratio slack arraylist_init would
+     * add, and slots need no zeroing as each is written before it is read.
+     */
+    Arraylist buffer = arraylist_init(0);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    if (!arraylist_reserve_uninit(buffer, rounded)) {
+        arraylist_free(buffer);
+        return NULL;
+    }
+    buffer->length = rounded;
+    Spscqueue q = cache_aligned_alloc(sizeof(struct Spscqueue));
+    if (q == NULL) {
+        arraylist_free(buffer);
+        return NULL;
+    }
+    q->buffer = buffer;
+    q->mask = rounded - 1;
+
+    return q;
+}
+
+/**
+ * Free a Spscqueue.  Neither thread may be using it.
+ *
+ * Inputs:
+ *     const Spscqueue q: Spscqueue to use.
+ * Returns:
+ *     Nothing.
+*/
+void spscqueue_free(const Spscqueue q) {
+    if (q) {
+        arraylist_free(q->buffer);
+        free(q);
+    }
+}
+
+/**
+ * Push a Value from the producer thread.
+ *
+ * Inputs:
+ *     const Spscqueue q: Spscqueue to use.
+ *     const Value value: Value to push.
+ * Returns:
+ *     bool: false if the Spscqueue is full,
+ *           true otherwise.
+*/
+bool spscqueue_push(const Spscqueue q, const Value value) {
+    return spscqueue_push_many(q, &value, 1) == 1;
+}
+
+/**
+ * Push up to n Values from the producer thread, publishing them together.
+ *
+ * Inputs:
+ *     const Spscqueue q: Spscqueue to use.
+ *     const Value *values: Values to push, in order.
+ *     const int n: Number of values.
+ * Returns:
+ *     int: -1 if the inputs are invalid,
+ *          number of Values pushed, fewer than n when full, otherwise.
+*/
+int spscqueue_push_many(const Spscqueue q, const Value *values, const int n) {
+    if (q == NULL || n < 0 || (values == NULL && n > 0)) {
+        return -1;
+    }
+
+    /* Only this thread writes tail, and head is re-read only when the cache says full */
+    const unsigned long capacity = q->mask + 1;
+    const unsigned long tail = q->tail;
+    unsigned long space = capacity - (tail - q->head_cache);
+    if (space < (unsigned long)n) {
+        q->head_cache = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+        space = capacity - (tail - q->head_cache);
+    }
+    const int count = space < (unsigned long)n ? (int)space : n;
+
+    Value *array = q->buffer->array;
+    for (int i = 0; i < count; i++) {
+        array[(tail + i) & q->mask] = values[i];
+    }
+    __atomic_store_n(&q->tail, tail + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+/**
+ * Pop a Value from the consumer thread.
+ *
+ * Inputs:
+ *     const Spscqueue q: Spscqueue to use.
+ *     Value *value: Where to store the Value popped.
+ * Returns:
+ *     bool: false if the Spscqueue is empty,
+ *           true otherwise.
+*/
+bool spscqueue_pop(const Spscqueue q, Value *value) {
+    return spscqueue_pop_many(q, value, 1) == 1;
+}
+
+/**
+ * Pop up to n Values from the consumer thread, releasing their slots together.
+ *
+ * Inputs:
+ *     const Spscqueue q: Spscqueue to use.
+ *     Value *values: Where to store the Values popped, in order.
+ *     const int n: Maximum number of values.
+ * Returns:
+ *     int: -1 if the inputs are invalid,
+ *          number of Values popped, fewer than n when empty, otherwise.
+*/
+int spscqueue_pop_many(const Spscqueue q, Value *values, const int n) {
+    if (q == NULL || n < 0 || (values == NULL && n > 0)) {
+        return -1;
+    }
+
+    /* Only this thread writes head, and tail is re-read only when the cache says empty */
+    const unsigned long head = q->head;
+    unsigned long ready = q->tail_cache - head;
+    if (ready < (unsigned long)n) {
+        q->tail_cache = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+        ready = q->tail_cache - head;
+    }
+    const int count = ready < (unsigned long)n ? (int)ready : n;
+
+    const Value *array = q->buffer->array;
+    for (int i = 0; i < count; i++) {
+        values[i] = array[(head + i) & q->mask];
+    }
+    __atomic_store_n(&q->head, head + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+/**
+ * Get the number of Values queued, exact only when both threads are idle.
+ *
+ * Inputs:
+ *     const Spscqueue q: Spscqueue to use.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          number of Values queued otherwise.
+*/
+int spscqueue_length(const Spscqueue q) {
+    if (q == NULL) {
+        return -1;
+    }
+    const unsigned long head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    const unsigned long tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    return (int)(tail - head);
+}
+
+/**
+ * Get the capacity of a Spscqueue.
+ *
+ * Inputs:
+ *     const Spscqueue q: Spscqueue to use.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          capacity otherwise.
+*/
+int spscqueue_capacity(const Spscqueue q) {
+    return q ? (int)(q->mask + 1) : -1;
+}
+
+/**
+ * Initialized a new Mpscqueue.
+ *
+ * Inputs:
+ *     const int capacity: Minimum number of Values held, rounded up to a power of two.
+ * Returns:
+ *     Mpscqueue: NULL if the process fails,
+ *                Mpscqueue that is newly created otherwise.
+*/
+Mpscqueue mpscqueue_init(const int capacity) {
+    const int rounded = round_capacity(capacity);
+    if (rounded < 0) {
+        return NULL;
+    }
+
+    /* Keep each sequence next to its Value so a slot is one cache access */
+    struct MpscSlot *slots = malloc(rounded * sizeof(*slots));
+    if (slots == NULL) {
+        return NULL;
+    }
+    Mpscqueue q = cache_aligned_alloc(sizeof(struct Mpscqueue));
+    if (q == NULL) {
+        free(slots);
+        return NULL;
+    }
+
+    /* Slot i is free for position i */
+    for (int i = 0; i < rounded; i++) {
+        slots[i].sequence = i;
+        slots[i].value = NULL;
+    }
+    q->slots = slots;
+    q->mask = rounded - 1;
+
+    return q;
+}
+
+/**
+ * Free a Mpscqueue.  No thread may be using it.
+ *
+ * Inputs:
+ *     const Mpscqueue q: Mpscqueue to use.
+ * Returns:
+ *     Nothing.
+*/
+void mpscqueue_free(const Mpscqueue q) {
+    if (q) {
+        free(q->slots);
+        free(q);
+    }
+}
+
+/**
+ * Push a Value from any producer thread.
+ *
+ * Inputs:
+ *     const Mpscqueue q: Mpscqueue to use.
+ *     const Value value: Value to push.
+ * Returns:
+ *     bool: false if the Mpscqueue is full,
+ *           true otherwise.
+*/
+bool mpscqueue_push(const Mpscqueue q, const Value value) {
+    if (q == NULL) {
+        return false;
+    }
+
+    unsigned long pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    for (;;) {
+        struct MpscSlot *slot = &q->slots[pos & q->mask];
+        const unsigned long sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        const long diff = (long)(sequence - pos);
+        if (diff == 0) {
+            /* Slot is free for pos, claim it, a failed claim reloads pos */
+            if (__atomic_compare_exchange_n(&q->tail, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                slot->value = value;
+                __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+        } else if (diff < 0) {
+            /* Slot still holds the Value from a lap ago */
+            return false;
+        } else {
+            /* Another producer claimed pos */
+            pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * Push up to n Values from any producer thread, claiming their slots
+ * with a single update of tail.  The Values stay contiguous in the
+ * queue, though the consumer may see the first before the last.
+ *
+ * Inputs:
+ *     const Mpscqueue q: Mpscqueue to use.
+ *     const Value *values: Values to push, in order.
+ *     const int n: Number of values.
+ * Returns:
+ *     int: -1 if the inputs are invalid,
+ *          number of Values pushed, fewer than n when full, otherwise.
+*/
+int mpscqueue_push_many(const Mpscqueue q, const Value *values, const int n) {
+    if (q == NULL || n < 0 || (values == NULL && n > 0)) {
+        return -1;
+    }
+
+    /*
+     * The consumer frees slots in order and stores head after them, so
+     * every position below head + capacity is free once claimed.  A
+     * stale head only undercounts the space, and a head past a stale
+     * pos overcounts it but then the claim fails.  Single pushes claim
+     * slots freed before head is stored, so tail may run more than
+     * capacity past head and the space must be compared signed.
+     */
+    const unsigned long capacity = q->mask + 1;
+    unsigned long pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    int count;
+    do {
+        const unsigned long head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+        const long space = (long)(capacity - (pos - head));
+        if (space <= 0) {
+            return 0;
+        }
+        count = space < n ? (int)space : n;
+        if (count == 0) {
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&q->tail, &pos, pos + count, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    for (int i = 0; i < count; i++) {
+        struct MpscSlot *slot = &q->slots[(pos + i) & q->mask];
+        slot->value = values[i];
+        __atomic_store_n(&slot->sequence, pos + i + 1, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/**
+ * Pop a Value from the consumer thread.
+ *
+ * Inputs:
+ *     const Mpscqueue q: Mpscqueue to use.
+ *     Value *value: Where to store the Value popped.
+ * Returns:
+ *     bool: false if no Value is published at the head,
+ *           true otherwise.
+*/
+bool mpscqueue_pop(const Mpscqueue q, Value *value) {
+    return mpscqueue_pop_many(q, value, 1) == 1;
+}
+
+/**
+ * Pop up to n Values from the consumer thread, stopping at the first
+ * slot claimed but not yet published.
+ *
+ * Inputs:
+ *     const Mpscqueue q: Mpscqueue to use.
+ *     Value *values: Where to store the Values popped, in order.
+ *     const int n: Maximum number of values.
+ * Returns:
+ *     int: -1 if the inputs are invalid,
+ *          number of Values popped otherwise.
+*/
+int mpscqueue_pop_many(const Mpscqueue q, Value *values, const int n) {
+    if (q == NULL || n < 0 || (values == NULL && n > 0)) {
+        return -1;
+    }
+
+    const unsigned long capacity = q->mask + 1;
+    const unsigned long head = q->head;
+    int count = 0;
+    while (count < n) {
+        struct MpscSlot *slot = &q->slots[(head + count) & q->mask];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != head + count + 1) {
+            break;
+        }
+        values[count] = slot->value;
+
+        /* Free the slot for the position one lap ahead */
+        __atomic_store_n(&slot->sequence, head + count + capacity, __ATOMIC_RELEASE);
+        count++;
+    }
+    if (count > 0) {
+        __atomic_store_n(&q->head, head + count, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/**
+ * Get the number of Values claimed and not popped, exact only when all
+ * threads are idle.
+ *
+ * Inputs:
+ *     const Mpscqueue q: Mpscqueue to use.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          number of Values queued otherwise.
+*/
+int mpscqueue_length(const Mpscqueue q) {
+    if (q == NULL) {
+        return -1;
+    }
+    const unsigned long head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    const unsigned long tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    return tail < head ? 0 : (int)(tail - head);
+}
+
+/**
+ * Get the capacity of a Mpscqueue.
+ *
+ * Inputs:
+ *     const Mpscqueue q: Mpscqueue to use.
+ * Returns:
+ *     int: -1 if the process fails,
+ *          capacity otherwise.
+*/
+int mpscqueue_capacity(const Mpscqueue q) {
+    return q ? (int)(q->mask + 1) : -1;
+}
@@ -0,0 +1,76 @@
+/**
+ * Header file for Spscqueue and Mpscqueue.
+ *
+ * Bounded lock-free ring queues of Values with a power-of-two capacity.
+ * Spscqueue hands Values from one producer thread to one consumer
+ * thread, each keeping a cached copy of the other's index so most
+ * operations touch no shared cache line.  Mpscqueue accepts many
+ * producers, which claim slots by advancing the tail and publish them
+ * through per-slot sequence numbers, for one consumer.  Indices written
+ * by different threads sit on their own cache lines.
+*/
+
+#ifndef RINGQUEUE_H_
+#define RINGQUEUE_H_
+
+#include <stdbool.h>
+#include "../../arraylist/code/arraylist.h"
+
+#define RINGQUEUE_CACHE_LINE 64
+#define RINGQUEUE_MAX_CAPACITY (1 << 30)
+
+typedef struct Spscqueue *Spscqueue;
+struct Spscqueue {
+    Arraylist buffer;  /* capacity slots, indexed by position & mask */
+    unsigned long mask;
+    _Alignas(RINGQUEUE_CACHE_LINE) unsigned long head;  /* Next position to pop, written by the consumer */
+    unsigned long tail_cache;  /* Consumer's last read of tail */
+    _Alignas(RINGQUEUE_CACHE_LINE) unsigned long tail;  /* Next position to push, written by the producer */
+    unsigned long head_cache;  /* Producer's last read of head */
+};
+
+typedef struct Mpscqueue *Mpscqueue;
+struct MpscSlot {
+    unsigned long sequence;  /* position when free, position + 1 when published */
+    Value value;
+};
+struct Mpscqueue {
+    struct MpscSlot *slots;  /* capacity slots, indexed by position & mask */
+    unsigned long mask;
+    _Alignas(RINGQUEUE_CACHE_LINE) unsigned long tail;  /* Next position to claim, shared by producers */
+    _Alignas(RINGQUEUE_CACHE_LINE) unsigned long head;  /* Next position to pop, written by the consumer */
+};
+
+/* Initialize/Free */
+Spscqueue spscqueue_init(const int capacity);
+void spscqueue_free(const Spscqueue q);
+
+/* Producer */
+bool spscqueue_push(const Spscqueue q, const Value value);
+int spscqueue_push_many(const Spscqueue q, const Value *values, const int n);
+
+/* Consumer */
+bool spscqueue_pop(const Spscqueue q, Value *value);
+int spscqueue_pop_many(const Spscqueue q, Value *values, const int n);
+
+/* Get size */
+int spscqueue_length(const Spscqueue q);
+int spscqueue_capacity(const Spscqueue q);
+
+/* Initialize/Free */
+Mpscqueue mpscqueue_init(const int capacity);
+void mpscqueue_free(const Mpscqueue q);
+
+/* Producers */
+bool mpscqueue_push(const Mpscqueue q, const Value value);
+int mpscqueue_push_many(const Mpscqueue q, const Value *values, const int n);
+
+/* Consumer */
+bool mpscqueue_pop(const Mpscqueue q, Value *value);
+int mpscqueue_pop_many(const Mpscqueue q, Value *values, const int n);
+
+/* Get size */
+int mpscqueue_length(const Mpscqueue q);
+int mpscqueue_capacity(const Mpscqueue q);
+
+#endif
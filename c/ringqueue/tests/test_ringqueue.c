@@ -0,0 +1,266 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../code/ringqueue.h"
+
+#define PRODUCERS 4
+#define ITEMS 50000
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_value(const Value result, const Value expected) {
+    assert(result == expected);
+}
+
+/**
+ * Case capacity is invalid.
+ * Case capacity rounds up to a power of two, allocating exactly that.
+ * Case indices sit on separate cache lines.
+*/
+void test_ringqueue_init() {
+    const Spscqueue s = spscqueue_init(100);
+    const Mpscqueue m = mpscqueue_init(64);
+
+    /* Test */
+    assert(spscqueue_init(0) == NULL);
+    assert(mpscqueue_init(-1) == NULL);
+    assert(spscqueue_init(RINGQUEUE_MAX_CAPACITY + 1) == NULL);
+    assert_int(spscqueue_capacity(s), 128);
+    assert_int(arraylist_length(s->buffer), 128);
+    assert_int(arraylist_capacity(s->buffer), 128);
+    const Spscqueue large = spscqueue_init((1 << 20) - 1);
+    assert_int(spscqueue_capacity(large), 1 << 20);
+    assert_int(arraylist_capacity(large->buffer), 1 << 20);
+    spscqueue_free(large);
+    assert_int(mpscqueue_capacity(m), 64);
+    assert_int(spscqueue_length(s), 0);
+    assert_int(mpscqueue_length(m), 0);
+    assert((uintptr_t)&s->tail / RINGQUEUE_CACHE_LINE != (uintptr_t)&s->head / RINGQUEUE_CACHE_LINE);
+    assert((uintptr_t)&m->tail / RINGQUEUE_CACHE_LINE != (uintptr_t)&m->head / RINGQUEUE_CACHE_LINE);
+
+    /* Free */
+    spscqueue_free(s);
+    mpscqueue_free(m);
+}
+
+/**
+ * Case fill to full, drain to empty, in order.
+ * Case wrap around the ring several times.
+ * Case batches stop at full and empty.
+ * Case invalid inputs.
+*/
+void test_spscqueue_push_pop() {
+    int values[8];
+    Value batch[8];
+    Value out;
+    const Spscqueue input = spscqueue_init(4);
+
+    /* Test */
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 4; i++) {
+            assert(spscqueue_push(input, &values[i]));
+        }
+        assert(!spscqueue_push(input, &values[4]));
+        assert_int(spscqueue_length(input), 4);
+        for (int i = 0; i < 4; i++) {
+            assert(spscqueue_pop(input, &out));
+            assert_value(out, &values[i]);
+        }
+        assert(!spscqueue_pop(input, &out));
+        assert(spscqueue_push(input, &values[0]));
+        assert(spscqueue_pop(input, &out));
+    }
+    for (int i = 0; i < 8; i++) {
+        batch[i] = &values[i];
+    }
+    assert_int(spscqueue_push_many(input, batch, 3), 3);
+    assert_int(spscqueue_push_many(input, batch + 3, 5), 1);
+    assert_int(spscqueue_pop_many(input, batch, 8), 4);
+    for (int i = 0; i < 4; i++) {
+        assert_value(batch[i], &values[i]);
+    }
+    assert_int(spscqueue_pop_many(input, batch, 8), 0);
+    assert_int(spscqueue_push_many(input, NULL, 1), -1);
+    assert_int(spscqueue_pop_many(input, batch, -1), -1);
+    assert(!spscqueue_push(NULL, &values[0]));
+
+    /* Free */
+    spscqueue_free(input);
+}
+
+/**
+ * Case fill to full, drain to empty, in order.
+ * Case single and batch pushes share the ring.
+ * Case invalid inputs.
+*/
+void test_mpscqueue_push_pop() {
+    int values[8];
+    Value batch[8];
+    Value out;
+    const Mpscqueue input = mpscqueue_init(4);
+
+    /* Test */
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 4; i++) {
+            assert(mpscqueue_push(input, &values[i]));
+        }
+        assert(!mpscqueue_push(input, &values[4]));
+        assert_int(mpscqueue_length(input), 4);
+        for (int i = 0; i < 4; i++) {
+            assert(mpscqueue_pop(input, &out));
+            assert_value(out, &values[i]);
+        }
+        assert(!mpscqueue_pop(input, &out));
+    }
+    for (int i = 0; i < 8; i++) {
+        batch[i] = &values[i];
+    }
+    assert(mpscqueue_push(input, &values[7]));
+    assert_int(mpscqueue_push_many(input, batch, 8), 3);
+    assert_int(mpscqueue_push_many(input, batch, 1), 0);
+    assert_int(mpscqueue_pop_many(input, batch, 2), 2);
+    assert_value(batch[0], &values[7]);
+    assert_value(batch[1], &values[0]);
+    assert(mpscqueue_push(input, &values[5]));
+    assert_int(mpscqueue_pop_many(input, batch, 8), 3);
+    assert_value(batch[0], &values[1]);
+    assert_value(batch[1], &values[2]);
+    assert_value(batch[2], &values[5]);
+    assert_int(mpscqueue_push_many(input, batch, -1), -1);
+    assert_int(mpscqueue_pop_many(NULL, batch, 1), -1);
+
+    /* Free */
+    mpscqueue_free(input);
+}
+
+/**
+ * Producer threads push ITEMS tagged Values, alternating single and batch
+ * pushes, yielding while the queue is full.
+*/
+struct Producer {
+    Spscqueue spsc;
+    Mpscqueue mpsc;
+    intptr_t id;
+};
+
+void *producer_fn(void *arg) {
+    const struct Producer *p = arg;
+    Value batch[16];
+    int i = 0;
+    while (i < ITEMS) {
+        int n = (i / 16) % 2 ? 1 : 16;
+        n = n < ITEMS - i ? n : ITEMS - i;
+        for (int j = 0; j < n; j++) {
+            batch[j] = (Value)((p->id << 32) | (intptr_t)(i + j + 1));
+        }
+        int pushed;
+        if (p->spsc) {
+            pushed = n == 1 ? spscqueue_push(p->spsc, batch[0]) : spscqueue_push_many(p->spsc, batch, n);
+        } else {
+            pushed = n == 1 ? mpscqueue_push(p->mpsc, batch[0]) : mpscqueue_push_many(p->mpsc, batch, n);
+        }
+        assert(pushed >= 0);
+        if (pushed == 0) {
+            sched_yield();
+        }
+        i += pushed;
+    }
+    return NULL;
+}
+
+/**
+ * Case one producer, every Value arrives once and in order.
+*/
+void test_spscqueue_threads() {
+    const Spscqueue input = spscqueue_init(256);
+    struct Producer producer = { input, NULL, 0 };
+    pthread_t thread;
+    Value batch[32];
+
+    /* Test */
+    pthread_create(&thread, NULL, producer_fn, &producer);
+    intptr_t expected = 1;
+    while (expected <= ITEMS) {
+        const int n = spscqueue_pop_many(input, batch, (int)(expected % 32) + 1);
+        if (n == 0) {
+            sched_yield();
+        }
+        for (int i = 0; i < n; i++) {
+            assert((intptr_t)batch[i] == expected);
+            expected++;
+        }
+    }
+    pthread_join(thread, NULL);
+    assert_int(spscqueue_length(input), 0);
+
+    /* Free */
+    spscqueue_free(input);
+}
+
+/**
+ * Case several producers, every Value arrives once and in order per producer.
+*/
+void test_mpscqueue_threads() {
+    const Mpscqueue input = mpscqueue_init(256);
+    struct Producer producers[PRODUCERS];
+    pthread_t threads[PRODUCERS];
+    intptr_t expected[PRODUCERS];
+    Value batch[32];
+
+    /* Test */
+    for (int i = 0; i < PRODUCERS; i++) {
+        producers[i] = (struct Producer){ NULL, input, i };
+        expected[i] = 1;
+        pthread_create(&threads[i], NULL, producer_fn, &producers[i]);
+    }
+    long remaining = (long)PRODUCERS * ITEMS;
+    while (remaining > 0) {
+        const int n = mpscqueue_pop_many(input, batch, 32);
+        if (n == 0) {
+            sched_yield();
+        }
+        for (int i = 0; i < n; i++) {
+            const intptr_t id = (intptr_t)batch[i] >> 32;
+            assert(id >= 0 && id < PRODUCERS);
+            assert(((intptr_t)batch[i] & 0xffffffff) == expected[id]);
+            expected[id]++;
+        }
+        remaining -= n;
+    }
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+        assert(expected[i] == ITEMS + 1);
+    }
+    assert_int(mpscqueue_length(input), 0);
+
+    /* Free */
+    mpscqueue_free(input);
+}
+
+const UnitTest TESTS[] = {
+    { test_ringqueue_init, "test_ringqueue_init" },
+    { test_spscqueue_push_pop, "test_spscqueue_push_pop" },
+    { test_mpscqueue_push_pop, "test_mpscqueue_push_pop" },
+    { test_spscqueue_threads, "test_spscqueue_threads" },
+    { test_mpscqueue_threads, "test_mpscqueue_threads" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
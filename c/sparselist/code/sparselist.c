@@ -0,0 +1,315 @@
+/**
+ * Implementation file for Sparselist.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "sparselist.h"
+
+static void clear_from(const Sparselist s, const int from);
+
+/**
+ * Initialized a new Sparselist.  No pages are allocated.
+ *
+ * Inputs:
+ *     const int initial_length: Initial length of unset elements.
+ * Returns:
+ *     Sparselist: NULL if the process fails,
+ *                 Sparselist that is newly created otherwise.
+*/
+Sparselist sparselist_init(const int initial_length) {
+    if (initial_length < 0) {
+        return NULL;
+    }
+
+    /* Malloc */
+    Sparselist s = malloc(sizeof(*s));
+    if (s == NULL) {
+        return NULL;
+    }
+
+    /* Initialize */
+    s->length = initial_length;
+    s->count = 0;
+    s->tables = NULL;
+
+    return s;
+}
+
+/**
+ * Free a Sparselist.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ * Returns:
+ *     Nothing.
+*/
+void sparselist_free(const Sparselist s) {
+    if (s) {
+        clear_from(s, 0);
+        free(s);
+    }
+}
+
+/**
+ * Query whether the Sparselist has a length of 0.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ * Returns:
+ *     bool: Whether the Sparselist has a length of 0.
+*/
+bool sparselist_empty(const Sparselist s) {
+    return s->length == 0;
+}
+
+/**
+ * Remove all elements from the Sparselist.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ * Returns:
+ *     Sparselist: NULL if the process fails,
+ *                 Sparselist otherwise.
+*/
+Sparselist sparselist_clear(const Sparselist s) {
+    return sparselist_resize(s, 0);
+}
+
+/**
+ * Get an index's Value from a Sparselist.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     Value: NULL if the process fails or the index is unset,
+ *            Value at the Sparselist's index otherwise.
+*/
+Value sparselist_get(const Sparselist s, const int index) {
+    if (index < 0 || index >= s->length || s->tables == NULL) {
+        return NULL;
+    }
+
+    const struct SparseTable *table =
+        s->tables[index >> (SPARSELIST_TABLE_BITS + SPARSELIST_PAGE_BITS)];
+    if (table == NULL) {
+        return NULL;
+    }
+    const struct SparsePage *page =
+        table->pages[(index >> SPARSELIST_PAGE_BITS) & (SPARSELIST_TABLE_LEN - 1)];
+    if (page == NULL) {
+        return NULL;
+    }
+    return page->values[index & (SPARSELIST_PAGE_LEN - 1)];
+}
+
+/**
+ * Set an index's Value from a Sparselist.  Setting NULL unsets the
+ * index and frees its page once the page holds no Values.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ *     const int index: The index to access.
+ *     const Value value: The Value to set at the Sparselist's index.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+Value sparselist_set(const Sparselist s, const int index, const Value value) {
+    if (index < 0 || index == INT_MAX) {
+        return NULL;
+    }
+
+    const int directory_index = index >> (SPARSELIST_TABLE_BITS + SPARSELIST_PAGE_BITS);
+    const int table_index = (index >> SPARSELIST_PAGE_BITS) & (SPARSELIST_TABLE_LEN - 1);
+    const int page_index = index & (SPARSELIST_PAGE_LEN - 1);
+
+    /* Expand to index */
+    if (index >= s->length) {
+        s->length = index + 1;
+    }
+
+    /* Unset */
+    if (value == NULL) {
+        struct SparseTable *table = s->tables ? s->tables[directory_index] : NULL;
+        struct SparsePage *page = table ? table->pages[table_index] : NULL;
+        if (page == NULL || page->values[page_index] == NULL) {
+            return NULL;
+        }
+        page->values[page_index] = NULL;
+        s->count--;
+        if (--page->count == 0) {
+            free(page);
+            table->pages[table_index] = NULL;
+            if (--table->count == 0) {
+                free(table);
+                s->tables[directory_index] = NULL;
+            }
+        }
+        return NULL;
+    }
+
+    /* Allocate directory, table and page on demand */
+    if (s->tables == NULL) {
+        s->tables = calloc(SPARSELIST_DIRECTORY_LEN, sizeof(*s->tables));
+        if (s->tables == NULL) {
+            return NULL;
+        }
+    }
+    struct SparseTable *table = s->tables[directory_index];
+    if (table == NULL) {
+        table = calloc(1, sizeof(*table));
+        if (table == NULL) {
+            return NULL;
+        }
+        s->tables[directory_index] = table;
+    }
+    struct SparsePage *page = table->pages[table_index];
+    if (page == NULL) {
+        page = calloc(1, sizeof(*page));
+        if (page == NULL) {
+            if (table->count == 0) {
+                free(table);
+                s->tables[directory_index] = NULL;
+            }
+            return NULL;
+        }
+        table->pages[table_index] = page;
+        table->count++;
+    }
+
+    /* Set value */
+    if (page->values[page_index] == NULL) {
+        page->count++;
+        s->count++;
+    }
+    page->values[page_index] = value;
+    return value;
+}
+
+/**
+ * Get the length of the elements of a Sparselist, including unset ones.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ * Returns:
+ *     int: The length of the elements in the Sparselist.
+*/
+int sparselist_length(const Sparselist s) {
+    return s->length;
+}
+
+/**
+ * Get the number of non-NULL Values in a Sparselist.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ * Returns:
+ *     int: The number of set elements in the Sparselist.
+*/
+int sparselist_count(const Sparselist s) {
+    return s->count;
+}
+
+/**
+ * Sets the length of the Sparselist, dropping Values past it.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ *     const int length: The new length to use.
+ * Returns:
+ *     Sparselist: NULL if the process fails,
+ *                 Sparselist otherwise.
+*/
+Sparselist sparselist_resize(const Sparselist s, const int length) {
+    if (length < 0) {
+        return NULL;
+    }
+    if (length < s->length) {
+        clear_from(s, length);
+    }
+    s->length = length;
+    return s;
+}
+
+/**
+ * Calls a function once for each non-NULL Value in the Sparselist,
+ * in index order, skipping unallocated pages.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to use.
+ *     void (*f)(int, Value): Function to call with each index and Value.
+ * Returns:
+ *     Nothing.
+*/
+void sparselist_foreach(const Sparselist s, void (*f)(int, Value)) {
+    if (s->tables == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < SPARSELIST_DIRECTORY_LEN; i++) {
+        const struct SparseTable *table = s->tables[i];
+        for (int j = 0; table && j < SPARSELIST_TABLE_LEN; j++) {
+            const struct SparsePage *page = table->pages[j];
+            const int first = ((i << SPARSELIST_TABLE_BITS) + j) << SPARSELIST_PAGE_BITS;
+            for (int k = 0, seen = 0; page && seen < page->count; k++) {
+                if (page->values[k]) {
+                    f(first + k, page->values[k]);
+                    seen++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Unset every Value at or past an index, freeing emptied pages, and the
+ * directory itself when clearing from 0.
+ *
+ * Inputs:
+ *     const Sparselist s: Sparselist to change.
+ *     const int from: First index to unset.
+ * Returns:
+ *     Nothing.
+*/
+static void clear_from(const Sparselist s, const int from) {
+    if (s->tables == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < SPARSELIST_DIRECTORY_LEN; i++) {
+        struct SparseTable *table = s->tables[i];
+        for (int j = 0; table && j < SPARSELIST_TABLE_LEN; j++) {
+            struct SparsePage *page = table->pages[j];
+            const int first = ((i << SPARSELIST_TABLE_BITS) + j) << SPARSELIST_PAGE_BITS;
+            if (page == NULL || from - first >= SPARSELIST_PAGE_LEN) {
+                continue;
+            }
+
+            /* Unset the part of the page past from */
+            for (int k = (from > first) ? (from - first) : 0; k < SPARSELIST_PAGE_LEN; k++) {
+                if (page->values[k]) {
+                    page->values[k] = NULL;
+                    page->count--;
+                    s->count--;
+                }
+            }
+            if (page->count == 0) {
+                free(page);
+                table->pages[j] = NULL;
+                table->count--;
+            }
+        }
+        if (table && table->count == 0) {
+            free(table);
+            s->tables[i] = NULL;
+        }
+    }
+
+    if (from == 0) {
+        free(s->tables);
+        s->tables = NULL;
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * Header file for Sparselist.
+ *
+ * A list of Values over a sparse index space.  Elements live in pages
+ * of SPARSELIST_PAGE_LEN slots reached through a two-level directory,
+ * and both directory tables and pages are only allocated once a
+ * non-NULL Value is written into them, so setting a far index costs
+ * memory for that index alone.  Unset indices read as NULL.
+*/
+
+#ifndef SPARSELIST_H_
+#define SPARSELIST_H_
+
+#include <stdbool.h>
+
+#define SPARSELIST_PAGE_BITS 9
+#define SPARSELIST_TABLE_BITS 11
+#define SPARSELIST_PAGE_LEN (1 << SPARSELIST_PAGE_BITS)
+#define SPARSELIST_TABLE_LEN (1 << SPARSELIST_TABLE_BITS)
+#define SPARSELIST_DIRECTORY_LEN (1 << (31 - SPARSELIST_TABLE_BITS - SPARSELIST_PAGE_BITS))
+
+typedef struct Sparselist *Sparselist;
+typedef void *Value;
+struct SparsePage {
+    int count;  /* Length of non-NULL Values in the page */
+    Value values[SPARSELIST_PAGE_LEN];
+};
+struct SparseTable {
+    int count;  /* Length of allocated pages in the table */
+    struct SparsePage *pages[SPARSELIST_TABLE_LEN];
+};
+struct Sparselist {
+    int length;  /* Length of elements, including unset ones */
+    int count;  /* Length of non-NULL Values */
+    struct SparseTable **tables;  /* Top-level directory, NULL until written */
+};
+
+/* Initialize/Free */
+Sparselist sparselist_init(const int initial_len);
+void sparselist_free(const Sparselist s);
+
+/* Get/Remove elements */
+bool sparselist_empty(const Sparselist s);
+Sparselist sparselist_clear(const Sparselist s);
+Value sparselist_get(const Sparselist s, const int index);
+Value sparselist_set(const Sparselist s, const int index, const Value value);
+
+/* Get size */
+int sparselist_length(const Sparselist s);
+int sparselist_count(const Sparselist s);
+
+/* Set size */
+Sparselist sparselist_resize(const Sparselist s, const int length);
+
+/* Iterate over non-NULL Values */
+void sparselist_foreach(const Sparselist s, void (*f)(int, Value));
+
+#endif
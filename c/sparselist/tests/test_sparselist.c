@@ -0,0 +1,196 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <assert.h>
+#include "../code/sparselist.h"
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+typedef struct TestValue {
+    Value result;
+    Value expected;
+} TestValue;
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_value(const Value result, const Value expected) {
+    assert(result == expected);
+}
+
+/**
+ * Case initial length is negative.
+ * Case default allocates no pages.
+*/
+void test_sparselist_init() {
+    const Sparselist inputs[] = {
+        sparselist_init(-1),
+        sparselist_init(1000000),
+    };
+
+    /* Test */
+    assert(inputs[0] == NULL);
+    assert_int(sparselist_length(inputs[1]), 1000000);
+    assert_int(sparselist_count(inputs[1]), 0);
+    assert(inputs[1]->tables == NULL);
+
+    /* Free */
+    sparselist_free(inputs[1]);
+}
+
+/**
+ * Case is empty.
+ * Case is not empty.
+*/
+void test_sparselist_empty() {
+    const Sparselist inputs[] = {
+        sparselist_init(0),
+        sparselist_init(1),
+    };
+
+    /* Test */
+    assert(sparselist_empty(inputs[0]));
+    assert(!sparselist_empty(inputs[1]));
+    assert(sparselist_empty(sparselist_clear(inputs[1])));
+
+    /* Free */
+    sparselist_free(inputs[0]);
+    sparselist_free(inputs[1]);
+}
+
+/**
+ * Case invalid index.
+ * Case unset index.
+ * Case default.
+*/
+void test_sparselist_get() {
+    int value = 7;
+    const Sparselist input = sparselist_init(0);
+    sparselist_set(input, 5000, &value);
+    const TestValue tests[] = {
+        { sparselist_get(input, -1), NULL },
+        { sparselist_get(input, 5001), NULL },
+        { sparselist_get(input, 4999), NULL },
+        { sparselist_get(input, 5000), &value },
+    };
+
+    const int num_tests = sizeof(tests) / sizeof(*tests);
+
+    /* Test */
+    for (int i = 0; i < num_tests; i++) {
+        assert_value(tests[i].result, tests[i].expected);
+    }
+
+    /* Free */
+    sparselist_free(input);
+}
+
+/**
+ * Case index below 0.
+ * Case far index allocates a single page.
+ * Case overwrite keeps count.
+ * Case unset frees emptied pages.
+*/
+void test_sparselist_set() {
+    int value = 7;
+    const Sparselist input = sparselist_init(0);
+
+    /* Test */
+    assert_value(sparselist_set(input, -1, &value), NULL);
+    assert_value(sparselist_set(input, INT_MAX - 1, &value), &value);
+    assert_value(sparselist_set(input, 1000000000, &value), &value);
+    assert_value(sparselist_set(input, 1000000000, &value), &value);
+    assert_int(sparselist_length(input), INT_MAX);
+    assert_int(sparselist_count(input), 2);
+    assert_value(sparselist_get(input, INT_MAX - 1), &value);
+
+    const int directory_index = 1000000000 >> (SPARSELIST_TABLE_BITS + SPARSELIST_PAGE_BITS);
+    assert_int(input->tables[directory_index]->count, 1);
+    assert_value(sparselist_set(input, 1000000000, NULL), NULL);
+    assert_int(sparselist_count(input), 1);
+    assert(input->tables[directory_index] == NULL);
+    assert_value(sparselist_get(input, 1000000000), NULL);
+
+    /* Free */
+    sparselist_free(input);
+}
+
+/**
+ * Case length is negative.
+ * Case shrink drops Values past the length.
+ * Case grow.
+ * Case shrink within the last page.
+*/
+void test_sparselist_resize() {
+    int value = 7;
+    const Sparselist input = sparselist_init(0);
+    sparselist_set(input, 10, &value);
+    sparselist_set(input, 600, &value);
+    sparselist_set(input, 3000000, &value);
+
+    /* Test */
+    assert(sparselist_resize(input, -1) == NULL);
+    assert(sparselist_resize(input, 600) == input);
+    assert_int(sparselist_count(input), 1);
+    assert_value(sparselist_get(input, 10), &value);
+    assert(sparselist_resize(input, 700) == input);
+    assert_value(sparselist_get(input, 600), NULL);
+    sparselist_set(input, INT_MAX - 1, &value);
+    assert(sparselist_resize(input, INT_MAX - 10) == input);
+    assert_int(sparselist_count(input), 1);
+    assert(sparselist_resize(input, INT_MAX) == input);
+    assert_value(sparselist_get(input, INT_MAX - 1), NULL);
+
+    /* Free */
+    sparselist_free(input);
+}
+
+/**
+ * Case visits only set indices in order.
+*/
+int foreach_indices[4];
+int foreach_counter = 0;
+void foreach_fn(int index, Value value) {
+    foreach_indices[foreach_counter++] = index;
+}
+void test_sparselist_foreach() {
+    int value = 7;
+    const Sparselist input = sparselist_init(0);
+    sparselist_set(input, 1000000000, &value);
+    sparselist_set(input, 3, &value);
+    sparselist_set(input, 512, &value);
+    sparselist_set(input, 511, &value);
+
+    /* Test */
+    sparselist_foreach(input, foreach_fn);
+    assert_int(foreach_counter, 4);
+    assert_int(foreach_indices[0], 3);
+    assert_int(foreach_indices[1], 511);
+    assert_int(foreach_indices[2], 512);
+    assert_int(foreach_indices[3], 1000000000);
+
+    /* Free */
+    sparselist_free(input);
+}
+
+const UnitTest TESTS[] = {
+    { test_sparselist_init, "test_sparselist_init" },
+    { test_sparselist_empty, "test_sparselist_empty" },
+    { test_sparselist_get, "test_sparselist_get" },
+    { test_sparselist_set, "test_sparselist_set" },
+    { test_sparselist_resize, "test_sparselist_resize" },
+    { test_sparselist_foreach, "test_sparselist_foreach" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
@@ -0,0 +1,583 @@
+/**
+ * Implementation file for Treelist.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include "treelist.h"
+
+/* Fewest entries a non-root node keeps, so merging two always fits */
+#define LEAF_MIN (TREELIST_LEAF_LEN / 4)
+#define BRANCH_MIN (TREELIST_BRANCH_LEN / 4)
+#define MAX_HEIGHT 32
+
+static int node_size(const void *node, const int height);
+static int node_capacity(const int height);
+static int find_child(const struct TreeBranch *b, int *index, const bool inserting);
+static int shift_right(void *left, void *right, const int n, const int height);
+static int shift_left(void *left, void *right, const int n, const int height);
+static bool split_child(struct TreeBranch *parent, const int i, const int height);
+static void fix_child(struct TreeBranch *parent, const int i, const int height);
+static void free_node(void *node, const int height);
+static bool insert(const Treelist t, const int index, const Value value);
+
+/**
+ * Initialized a new Treelist.
+ *
+ * Inputs:
+ *     const int initial_length: Initial length of NULL elements.
+ * Returns:
+ *     Treelist: NULL if the process fails,
+ *               Treelist that is newly created otherwise.
+*/
+Treelist treelist_init(const int initial_length) {
+    if (initial_length < 0) {
+        return NULL;
+    }
+
+    /* Malloc */
+    Treelist t = malloc(sizeof(*t));
+    struct TreeLeaf *leaf = calloc(1, sizeof(*leaf));
+
+    if (t == NULL || leaf == NULL) {
+        free(t);
+        free(leaf);
+        return NULL;
+    }
+
+    /* Initialize */
+    t->length = 0;
+    t->height = 0;
+    t->root = leaf;
+    t->first = leaf;
+
+    if (!treelist_resize(t, initial_length)) {
+        treelist_free(t);
+        return NULL;
+    }
+    return t;
+}
+
+/**
+ * Free a Treelist.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ * Returns:
+ *     Nothing.
+*/
+void treelist_free(const Treelist t) {
+    if (t) {
+        free_node(t->root, t->height);
+        free(t);
+    }
+}
+
+/**
+ * Query whether the Treelist has a length of 0.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ * Returns:
+ *     bool: Whether the Treelist has a length of 0.
+*/
+bool treelist_empty(const Treelist t) {
+    return t->length == 0;
+}
+
+/**
+ * Remove all elements from the Treelist.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ * Returns:
+ *     Treelist: NULL if the process fails,
+ *               Treelist otherwise.
+*/
+Treelist treelist_clear(const Treelist t) {
+    return treelist_resize(t, 0);
+}
+
+/**
+ * Get an index's Value from a Treelist.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value at the Treelist's index otherwise.
+*/
+Value treelist_get(const Treelist t, const int index) {
+    if (index < 0 || index >= t->length) {
+        return NULL;
+    }
+
+    int local = index;
+    const void *node = t->root;
+    for (int h = t->height; h > 0; h--) {
+        const struct TreeBranch *b = node;
+        node = b->children[find_child(b, &local, false)];
+    }
+    return ((const struct TreeLeaf *)node)->values[local];
+}
+
+/**
+ * Get an index's Value, remove that item, and shift elements over.
+ * Underfull nodes on the way down borrow from or merge with a sibling.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ *     const int index: The index to access.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value at the Treelist's index otherwise.
+*/
+Value treelist_pop(const Treelist t, const int index) {
+    if (index < 0 || index >= t->length) {
+        return NULL;
+    }
+
+    /* Descend, topping up each child before entering it */
+    int remaining = index;
+    void *node = t->root;
+    for (int h = t->height; h > 0; h--) {
+        struct TreeBranch *b = node;
+        int local = remaining;
+        int i = find_child(b, &local, false);
+        if (node_size(b->children[i], h - 1) <= (h > 1 ? BRANCH_MIN : LEAF_MIN)) {
+            fix_child(b, i, h - 1);
+            local = remaining;
+            i = find_child(b, &local, false);
+        }
+        remaining = local;
+        b->counts[i]--;
+        node = b->children[i];
+    }
+
+    /* Remove from the leaf */
+    struct TreeLeaf *leaf = node;
+    const Value value = leaf->values[remaining];
+    memmove(leaf->values + remaining, leaf->values + remaining + 1, (leaf->length - remaining - 1) * sizeof(Value));
+    leaf->length--;
+    t->length--;
+
+    /* Drop roots left with a single child */
+    while (t->height > 0 && ((struct TreeBranch *)t->root)->length == 1) {
+        struct TreeBranch *root = t->root;
+        t->root = root->children[0];
+        t->height--;
+        free(root);
+    }
+    return value;
+}
+
+/**
+ * Set an index's Value from a Treelist.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ *     const int index: The index to access.
+ *     const Value value: The Value to set at the Treelist's index.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+Value treelist_set(const Treelist t, const int index, const Value value) {
+    if (index < 0 || index == INT_MAX) {
+        return NULL;
+    }
+
+    /* Expand to index */
+    if (index >= t->length && !treelist_resize(t, index + 1)) {
+        return NULL;
+    }
+
+    int local = index;
+    void *node = t->root;
+    for (int h = t->height; h > 0; h--) {
+        struct TreeBranch *b = node;
+        node = b->children[find_child(b, &local, false)];
+    }
+    ((struct TreeLeaf *)node)->values[local] = value;
+    return value;
+}
+
+/**
+ * Set an index's Value, shifting elements further back in a Treelist.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ *     const int index: The index to access.
+ *     const Value value: The Value to set at the Treelist's index.
+ * Returns:
+ *     Value: NULL if the process fails,
+ *            Value that was inserted otherwise.
+*/
+Value treelist_push(const Treelist t, const int index, const Value value) {
+    if (index < 0 || index == INT_MAX || t->length == INT_MAX) {
+        return NULL;
+    }
+
+    /* Expand to index */
+    if (index > t->length && !treelist_resize(t, index)) {
+        return NULL;
+    }
+    return insert(t, index, value) ? value : NULL;
+}
+
+/**
+ * Get the length of the elements of a Treelist.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ * Returns:
+ *     int: The length of the elements in the Treelist.
+*/
+int treelist_length(const Treelist t) {
+    return t->length;
+}
+
+/**
+ * Sets the length of the Treelist, adding NULL elements or dropping
+ * elements at the end.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ *     const int length: The new length to use.
+ * Returns:
+ *     Treelist: NULL if the process fails,
+ *               Treelist otherwise.
+*/
+Treelist treelist_resize(const Treelist t, const int length) {
+    if (length < 0) {
+        return NULL;
+    }
+
+    /* Drop everything at once */
+    if (length == 0 && t->length > 0) {
+        struct TreeLeaf *leaf = calloc(1, sizeof(*leaf));
+        if (leaf == NULL) {
+            return NULL;
+        }
+        free_node(t->root, t->height);
+        t->length = 0;
+        t->height = 0;
+        t->root = leaf;
+        t->first = leaf;
+    }
+
+    while (t->length > length) {
+        treelist_pop(t, t->length - 1);
+    }
+    while (t->length < length) {
+        if (t->length == INT_MAX || !insert(t, t->length, NULL)) {
+            return NULL;
+        }
+    }
+    return t;
+}
+
+/**
+ * Calls a function once for each element in the Treelist,
+ * from indices 0 to length - 1, following the linked leaves.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ *     void (*f)(Value): Function to call for each element.
+ * Returns:
+ *     Nothing.
+*/
+void treelist_foreach(const Treelist t, void (*f)(Value)) {
+    for (const struct TreeLeaf *leaf = t->first; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->length; i++) {
+            f(leaf->values[i]);
+        }
+    }
+}
+
+/**
+ * Get the number of entries, values or children, held by a node.
+ *
+ * Inputs:
+ *     const void *node: Leaf or branch.
+ *     const int height: 0 for a leaf.
+ * Returns:
+ *     int: The length of the node.
+*/
+static int node_size(const void *node, const int height) {
+    return height
+        ? ((const struct TreeBranch *)node)->length
+        : ((const struct TreeLeaf *)node)->length;
+}
+
+/**
+ * Get the most entries a node at a height can hold.
+ *
+ * Inputs:
+ *     const int height: 0 for a leaf.
+ * Returns:
+ *     int: The capacity of the node.
+*/
+static int node_capacity(const int height) {
+    return height ? TREELIST_BRANCH_LEN : TREELIST_LEAF_LEN;
+}
+
+/**
+ * Find the child of a branch holding an index.
+ *
+ * Inputs:
+ *     const struct TreeBranch *b: Branch to search.
+ *     int *index: Index within the branch, set to the index within the child.
+ *     const bool inserting: Whether an index just past a child's
+ *                           elements stays in that child, for appending.
+ * Returns:
+ *     int: Position of the child in the branch.
+*/
+static int find_child(const struct TreeBranch *b, int *index, const bool inserting) {
+    int i = 0;
+    while (i < b->length - 1 && (*index > b->counts[i] || (!inserting && *index == b->counts[i]))) {
+        *index -= b->counts[i];
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Move the last entries of a node to the front of its right sibling.
+ *
+ * Inputs:
+ *     void *left: Node to move from.
+ *     void *right: Node to move to.
+ *     const int n: Number of entries to move.
+ *     const int height: 0 for leaves.
+ * Returns:
+ *     int: Number of elements moved.
+*/
+static int shift_right(void *left, void *right, const int n, const int height) {
+    if (height == 0) {
+        struct TreeLeaf *l = left, *r = right;
+        memmove(r->values + n, r->values, r->length * sizeof(Value));
+        memcpy(r->values, l->values + l->length - n, n * sizeof(Value));
+        l->length -= n;
+        r->length += n;
+        return n;
+    }
+
+    struct TreeBranch *l = left, *r = right;
+    int moved = 0;
+    for (int i = l->length - n; i < l->length; i++) {
+        moved += l->counts[i];
+    }
+    memmove(r->counts + n, r->counts, r->length * sizeof(int));
+    memmove(r->children + n, r->children, r->length * sizeof(void *));
+    memcpy(r->counts, l->counts + l->length - n, n * sizeof(int));
+    memcpy(r->children, l->children + l->length - n, n * sizeof(void *));
+    l->length -= n;
+    r->length += n;
+    return moved;
+}
+
+/**
+ * Move the first entries of a node to the end of its left sibling.
+ *
+ * Inputs:
+ *     void *left: Node to move to.
+ *     void *right: Node to move from.
+ *     const int n: Number of entries to move.
+ *     const int height: 0 for leaves.
+ * Returns:
+ *     int: Number of elements moved.
+*/
+static int shift_left(void *left, void *right, const int n, const int height) {
+    if (height == 0) {
+        struct TreeLeaf *l = left, *r = right;
+        memcpy(l->values + l->length, r->values, n * sizeof(Value));
+        memmove(r->values, r->values + n, (r->length - n) * sizeof(Value));
+        l->length += n;
+        r->length -= n;
+        return n;
+    }
+
+    struct TreeBranch *l = left, *r = right;
+    int moved = 0;
+    for (int i = 0; i < n; i++) {
+        moved += r->counts[i];
+    }
+    memcpy(l->counts + l->length, r->counts, n * sizeof(int));
+    memcpy(l->children + l->length, r->children, n * sizeof(void *));
+    memmove(r->counts, r->counts + n, (r->length - n) * sizeof(int));
+    memmove(r->children, r->children + n, (r->length - n) * sizeof(void *));
+    l->length += n;
+    r->length -= n;
+    return moved;
+}
+
+/**
+ * Split a full child of a branch in half, adding the new right half as
+ * the next child.  The branch must not be full.
+ *
+ * Inputs:
+ *     struct TreeBranch *parent: Branch holding the child.
+ *     const int i: Position of the child.
+ *     const int height: Height of the child, 0 for a leaf.
+ * Returns:
+ *     bool: Whether the split succeeded.
+*/
+static bool split_child(struct TreeBranch *parent, const int i, const int height) {
+    void *child = parent->children[i];
+    void *sibling = height
+        ? calloc(1, sizeof(struct TreeBranch))
+        : calloc(1, sizeof(struct TreeLeaf));
+    if (sibling == NULL) {
+        return false;
+    }
+
+    const int size = node_size(child, height);
+    const int moved = shift_right(child, sibling, size - size / 2, height);
+    if (height == 0) {
+        ((struct TreeLeaf *)sibling)->next = ((struct TreeLeaf *)child)->next;
+        ((struct TreeLeaf *)child)->next = sibling;
+    }
+
+    /* Add the sibling after the child */
+    memmove(parent->counts + i + 2, parent->counts + i + 1, (parent->length - i - 1) * sizeof(int));
+    memmove(parent->children + i + 2, parent->children + i + 1, (parent->length - i - 1) * sizeof(void *));
+    parent->counts[i] -= moved;
+    parent->counts[i + 1] = moved;
+    parent->children[i + 1] = sibling;
+    parent->length++;
+    return true;
+}
+
+/**
+ * Top up an underfull child of a branch by borrowing half the surplus
+ * of a sibling, or merge it with a sibling when neither has a surplus.
+ *
+ * Inputs:
+ *     struct TreeBranch *parent: Branch holding the child, with at
+ *                                least two children.
+ *     const int i: Position of the child.
+ *     const int height: Height of the child, 0 for a leaf.
+ * Returns:
+ *     Nothing.
+*/
+static void fix_child(struct TreeBranch *parent, const int i, const int height) {
+    const int min = height ? BRANCH_MIN : LEAF_MIN;
+    const int size = node_size(parent->children[i], height);
+
+    /* Borrow */
+    if (i > 0 && node_size(parent->children[i - 1], height) > min + 1) {
+        const int n = (node_size(parent->children[i - 1], height) - size) / 2;
+        const int moved = shift_right(parent->children[i - 1], parent->children[i], n, height);
+        parent->counts[i - 1] -= moved;
+        parent->counts[i] += moved;
+        return;
+    }
+    if (i + 1 < parent->length && node_size(parent->children[i + 1], height) > min + 1) {
+        const int n = (node_size(parent->children[i + 1], height) - size) / 2;
+        const int moved = shift_left(parent->children[i], parent->children[i + 1], n, height);
+        parent->counts[i] += moved;
+        parent->counts[i + 1] -= moved;
+        return;
+    }
+
+    /* Merge the right of a pair into the left */
+    const int l = (i > 0) ? i - 1 : i;
+    void *left = parent->children[l];
+    void *right = parent->children[l + 1];
+    parent->counts[l] += shift_left(left, right, node_size(right, height), height);
+    if (height == 0) {
+        ((struct TreeLeaf *)left)->next = ((struct TreeLeaf *)right)->next;
+    }
+    free(right);
+    memmove(parent->counts + l + 1, parent->counts + l + 2, (parent->length - l - 2) * sizeof(int));
+    memmove(parent->children + l + 1, parent->children + l + 2, (parent->length - l - 2) * sizeof(void *));
+    parent->length--;
+}
+
+/**
+ * Free a node and everything under it.
+ *
+ * Inputs:
+ *     void *node: Leaf or branch.
+ *     const int height: 0 for a leaf.
+ * Returns:
+ *     Nothing.
+*/
+static void free_node(void *node, const int height) {
+    if (height > 0) {
+        struct TreeBranch *b = node;
+        for (int i = 0; i < b->length; i++) {
+            free_node(b->children[i], height - 1);
+        }
+    }
+    free(node);
+}
+
+/**
+ * Insert a Value at an index from 0 to the length.  Full nodes on the
+ * way down are split first, so a failed allocation leaves the elements
+ * unchanged and only the tree's shape differs.
+ *
+ * Inputs:
+ *     const Treelist t: Treelist to use.
+ *     const int index: The index to insert at.
+ *     const Value value: The Value to insert, may be NULL.
+ * Returns:
+ *     bool: Whether the Value was inserted.
+*/
+static bool insert(const Treelist t, const int index, const Value value) {
+    /* Grow a level when the root is full */
+    if (node_size(t->root, t->height) == node_capacity(t->height)) {
+        struct TreeBranch *root = calloc(1, sizeof(*root));
+        if (root == NULL) {
+            return false;
+        }
+        root->length = 1;
+        root->counts[0] = t->length;
+        root->children[0] = t->root;
+        if (!split_child(root, 0, t->height)) {
+            free(root);
+            return false;
+        }
+        t->root = root;
+        t->height++;
+    }
+
+    /* Descend, splitting each full child before entering it */
+    struct TreeBranch *path[MAX_HEIGHT];
+    int slots[MAX_HEIGHT];
+    int remaining = index;
+    void *node = t->root;
+    for (int h = t->height; h > 0; h--) {
+        struct TreeBranch *b = node;
+        int local = remaining;
+        int i = find_child(b, &local, true);
+        if (node_size(b->children[i], h - 1) == node_capacity(h - 1)) {
+            if (!split_child(b, i, h - 1)) {
+                return false;
+            }
+            local = remaining;
+            i = find_child(b, &local, true);
+        }
+        remaining = local;
+        path[h - 1] = b;
+        slots[h - 1] = i;
+        node = b->children[i];
+    }
+
+    /* Insert into the leaf, then count it on the path */
+    struct TreeLeaf *leaf = node;
+    memmove(leaf->values + remaining + 1, leaf->values + remaining, (leaf->length - remaining) * sizeof(Value));
+    leaf->values[remaining] = value;
+    leaf->length++;
+    for (int h = 0; h < t->height; h++) {
+        path[h]->counts[slots[h]]++;
+    }
+    t->length++;
+    return true;
+}
+
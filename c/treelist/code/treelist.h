@@ -0,0 +1,58 @@
+/**
+ * Header file for Treelist.
+ *
+ * A list of Values in a counted B+-tree.  Values live in leaves of up to
+ * TREELIST_LEAF_LEN contiguous slots linked in order, and each branch
+ * keeps the element count under every child, so get, set, push and pop
+ * at any index take O(log N) and sequential iteration walks the leaves.
+*/
+
+#ifndef TREELIST_H_
+#define TREELIST_H_
+
+#include <stdbool.h>
+
+#define TREELIST_LEAF_LEN 64
+#define TREELIST_BRANCH_LEN 32
+
+typedef struct Treelist *Treelist;
+typedef void *Value;
+struct TreeLeaf {
+    int length;  /* Length of values */
+    struct TreeLeaf *next;  /* Following leaf, NULL for the last */
+    Value values[TREELIST_LEAF_LEN];
+};
+struct TreeBranch {
+    int length;  /* Length of children */
+    int counts[TREELIST_BRANCH_LEN];  /* Elements under each child */
+    void *children[TREELIST_BRANCH_LEN];  /* Branches, or leaves one level up */
+};
+struct Treelist {
+    int length;  /* Length of elements */
+    int height;  /* Branch levels above the leaves, 0 if the root is a leaf */
+    void *root;
+    struct TreeLeaf *first;  /* Leftmost leaf, where iteration starts */
+};
+
+/* Initialize/Free */
+Treelist treelist_init(const int initial_len);
+void treelist_free(const Treelist t);
+
+/* Get/Remove elements */
+bool treelist_empty(const Treelist t);
+Treelist treelist_clear(const Treelist t);
+Value treelist_get(const Treelist t, const int index);
+Value treelist_pop(const Treelist t, const int index);
+Value treelist_set(const Treelist t, const int index, const Value value);
+Value treelist_push(const Treelist t, const int index, const Value value);
+
+/* Get size */
+int treelist_length(const Treelist t);
+
+/* Set size */
+Treelist treelist_resize(const Treelist t, const int length);
+
+/* Iterate */
+void treelist_foreach(const Treelist t, void (*f)(Value));
+
+#endif
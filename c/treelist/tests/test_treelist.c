@@ -0,0 +1,244 @@
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <assert.h>
+#include "../code/treelist.h"
+
+typedef struct UnitTest {
+    void (*fn)();
+    char *name;
+} UnitTest;
+
+void assert_int(const int result, const int expected) {
+    assert(result == expected);
+}
+
+void assert_value(const Value result, const Value expected) {
+    assert(result == expected);
+}
+
+/**
+ * Check counts, fill and leaf links of a subtree, returning its count.
+*/
+int check_node(const void *node, const int height, const bool root, const struct TreeLeaf **next_leaf) {
+    if (height == 0) {
+        const struct TreeLeaf *leaf = node;
+        assert(leaf == *next_leaf);
+        assert(root || leaf->length >= TREELIST_LEAF_LEN / 4);
+        *next_leaf = leaf->next;
+        return leaf->length;
+    }
+
+    const struct TreeBranch *b = node;
+    assert(b->length >= (root ? 2 : TREELIST_BRANCH_LEN / 4));
+    int count = 0;
+    for (int i = 0; i < b->length; i++) {
+        assert_int(check_node(b->children[i], height - 1, false, next_leaf), b->counts[i]);
+        count += b->counts[i];
+    }
+    return count;
+}
+
+void assert_treelist(const Treelist t, Value *expected, const int length) {
+    const struct TreeLeaf *next_leaf = t->first;
+    assert_int(check_node(t->root, t->height, true, &next_leaf), length);
+    assert(next_leaf == NULL);
+    assert_int(treelist_length(t), length);
+    for (int i = 0; i < length; i++) {
+        assert_value(treelist_get(t, i), expected[i]);
+    }
+}
+
+/**
+ * Case initial length is negative.
+ * Case default.
+ * Case initial length spans several leaves.
+*/
+void test_treelist_init() {
+    const Treelist inputs[] = {
+        treelist_init(-1),
+        treelist_init(0),
+        treelist_init(1000),
+    };
+
+    /* Test */
+    assert(inputs[0] == NULL);
+    assert_int(treelist_length(inputs[1]), 0);
+    assert_int(treelist_length(inputs[2]), 1000);
+    assert(inputs[2]->height > 0);
+    assert_value(treelist_get(inputs[2], 999), NULL);
+
+    /* Free */
+    treelist_free(inputs[1]);
+    treelist_free(inputs[2]);
+}
+
+/**
+ * Case is empty.
+ * Case is not empty, then cleared.
+*/
+void test_treelist_empty() {
+    const Treelist inputs[] = {
+        treelist_init(0),
+        treelist_init(500),
+    };
+
+    /* Test */
+    assert(treelist_empty(inputs[0]));
+    assert(!treelist_empty(inputs[1]));
+    assert(treelist_clear(inputs[1]) == inputs[1]);
+    assert(treelist_empty(inputs[1]));
+    assert_int(inputs[1]->height, 0);
+
+    /* Free */
+    treelist_free(inputs[0]);
+    treelist_free(inputs[1]);
+}
+
+/**
+ * Case set within the length.
+ * Case set past the length expands with NULL.
+ * Case invalid indices.
+*/
+void test_treelist_get_set() {
+    int values[3];
+    const Treelist input = treelist_init(100);
+
+    /* Test */
+    assert_value(treelist_set(input, 50, &values[0]), &values[0]);
+    assert_value(treelist_get(input, 50), &values[0]);
+    assert_value(treelist_set(input, 300, &values[1]), &values[1]);
+    assert_int(treelist_length(input), 301);
+    assert_value(treelist_get(input, 299), NULL);
+    assert_value(treelist_get(input, 300), &values[1]);
+    assert_value(treelist_set(input, -1, &values[2]), NULL);
+    assert_value(treelist_get(input, -1), NULL);
+    assert_value(treelist_get(input, 301), NULL);
+
+    /* Free */
+    treelist_free(input);
+}
+
+/**
+ * Case random pushes and pops match an array, keeping the tree balanced.
+ * Case push past the length expands with NULL.
+ * Case invalid indices.
+*/
+void test_treelist_push_pop() {
+    const int max_length = 20000;
+    int *values = malloc(max_length * sizeof(*values));
+    Value *expected = malloc(max_length * sizeof(*expected));
+    int length = 0;
+    const Treelist input = treelist_init(0);
+    srand(7);
+
+    /* Test */
+    for (int round = 0; round < 4; round++) {
+        /* Grow, mostly in the middle */
+        while (length < max_length) {
+            const int index = rand() % (length + 1);
+            for (int i = length; i > index; i--) {
+                expected[i] = expected[i - 1];
+            }
+            expected[index] = &values[length];
+            assert_value(treelist_push(input, index, &values[length]), &values[length]);
+            length++;
+        }
+        assert_treelist(input, expected, length);
+
+        /* Shrink to a few elements */
+        while (length > 10 * round) {
+            const int index = rand() % length;
+            assert_value(treelist_pop(input, index), expected[index]);
+            for (int i = index; i < length - 1; i++) {
+                expected[i] = expected[i + 1];
+            }
+            length--;
+        }
+        assert_treelist(input, expected, length);
+    }
+    assert_value(treelist_push(input, length + 2, &values[0]), &values[0]);
+    assert_value(treelist_get(input, length), NULL);
+    assert_value(treelist_get(input, length + 2), &values[0]);
+    assert_value(treelist_push(input, -1, &values[0]), NULL);
+    assert_value(treelist_pop(input, -1), NULL);
+    assert_value(treelist_pop(input, length + 3), NULL);
+
+    /* Free */
+    treelist_free(input);
+    free(values);
+    free(expected);
+}
+
+/**
+ * Case grow with NULL.
+ * Case shrink keeps the front.
+ * Case negative length.
+*/
+void test_treelist_resize() {
+    int values[200];
+    Value expected[200];
+    const Treelist input = treelist_init(0);
+    for (int i = 0; i < 200; i++) {
+        treelist_push(input, i, &values[i]);
+        expected[i] = &values[i];
+    }
+
+    /* Test */
+    assert(treelist_resize(input, 70) == input);
+    assert_treelist(input, expected, 70);
+    assert(treelist_resize(input, 150) == input);
+    for (int i = 70; i < 150; i++) {
+        expected[i] = NULL;
+    }
+    assert_treelist(input, expected, 150);
+    assert(treelist_resize(input, -1) == NULL);
+
+    /* Free */
+    treelist_free(input);
+}
+
+/**
+ * Case visits every element in order across leaves.
+*/
+int foreach_counter = 0;
+int foreach_ordered = 1;
+void foreach_fn(Value input) {
+    foreach_ordered &= (*(int *)input == foreach_counter);
+    foreach_counter++;
+}
+void test_treelist_foreach() {
+    int values[1000];
+    const Treelist input = treelist_init(0);
+    for (int i = 999; i >= 0; i--) {
+        values[i] = i;
+        treelist_push(input, 0, &values[i]);
+    }
+
+    /* Test */
+    treelist_foreach(input, foreach_fn);
+    assert_int(foreach_counter, 1000);
+    assert(foreach_ordered);
+
+    /* Free */
+    treelist_free(input);
+}
+
+const UnitTest TESTS[] = {
+    { test_treelist_init, "test_treelist_init" },
+    { test_treelist_empty, "test_treelist_empty" },
+    { test_treelist_get_set, "test_treelist_get_set" },
+    { test_treelist_push_pop, "test_treelist_push_pop" },
+    { test_treelist_resize, "test_treelist_resize" },
+    { test_treelist_foreach, "test_treelist_foreach" },
+};
+
+const int NUM_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);
+
+int main(int argc, char *argv[]) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        TESTS[i].fn();
+        printf("+ PASSED %s\n", TESTS[i].name);
+    }
+}
@@ -2,4 +2,45 @@
 
 gcc c/arraylist/code/arraylist.c c/arraylist/tests/test_arraylist.c
 valgrind ./a.out
-rm ./a.out
\ No newline at end of file
+rm ./a.out
+
+gcc -pthread c/arraylist/code/arraylist.c c/concurrent_arraylist/code/concurrent_arraylist.c c/concurrent_arraylist/tests/test_concurrent_arraylist.c
+valgrind ./a.out
+rm ./a.out
+
+gcc c/bitlist/code/bitlist.c c/bitlist/tests/test_bitlist.c
+valgrind ./a.out
+rm ./a.out
+
+gcc c/packedlist/code/packedlist.c c/packedlist/tests/test_packedlist.c
+valgrind ./a.out
+rm ./a.out
+
+gcc c/columnlist/code/columnlist.c c/columnlist/tests/test_columnlist.c
+valgrind ./a.out
+rm ./a.out
+
+gcc c/sparselist/code/sparselist.c c/sparselist/tests/test_sparselist.c
+valgrind ./a.out
+rm ./a.out
+
+gcc c/arraylist/code/arraylist.c c/heap/code/heap.c c/heap/tests/test_heap.c
+valgrind ./a.out
+rm ./a.out
+
+gcc -pthread c/arraylist/code/arraylist.c c/arraylist/code/arraylist_parallel.c c/arraylist/tests/test_arraylist_parallel.c
+valgrind ./a.out
+rm ./a.out
+
+gcc c/treelist/code/treelist.c c/treelist/tests/test_treelist.c
+valgrind ./a.out
+rm ./a.out
+
+gcc -pthread c/arraylist/code/arraylist.c c/ringqueue/code/ringqueue.c c/ringqueue/tests/test_ringqueue.c
+valgrind ./a.out
+rm ./a.out
+
+gcc -c c/arraylist/code/arraylist.c -o arraylist.o
+g++ -std=c++17 -D_GLIBCXX_USE_TBB_PAR_BACKEND=0 c/arraylist/tests/test_arraylist.cpp arraylist.o
+valgrind ./a.out
+rm ./a.out arraylist.o